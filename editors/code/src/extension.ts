@@ -416,6 +416,11 @@ const startLanguageServer = async (context: vscode.ExtensionContext) => {
     }
   }
 
+  // Persist diagnostics between sessions in the workspace storage
+  if (context.storageUri) {
+    addArg(`--cache-directory=${context.storageUri.fsPath}`);
+  }
+
   // Handle FFlags
   const fflags: FFlags = {};
   const fflagsConfig = vscode.workspace.getConfiguration("luau-lsp.fflags");
@@ -535,6 +540,40 @@ export async function activate(context: vscode.ExtensionContext) {
     })
   );
 
+  context.subscriptions.push(
+    vscode.commands.registerCommand("luau-lsp.profile", async () => {
+      if (!client) {
+        return;
+      }
+
+      const duration = await vscode.window.showInputBox({
+        prompt: "Duration to profile the language server for (in seconds)",
+        value: "10",
+        validateInput: (value) =>
+          Number(value) > 0 ? undefined : "Duration must be a positive number",
+      });
+      if (!duration) {
+        return;
+      }
+
+      const output = await vscode.window.showSaveDialog({
+        title: "Save profile (folded stacks)",
+        filters: { "Folded stacks": ["folded", "txt"] },
+      });
+      if (!output) {
+        return;
+      }
+
+      await client.sendRequest("luau-lsp/profile", {
+        duration: Number(duration),
+        path: output.fsPath,
+      });
+      vscode.window.showInformationMessage(
+        `Profiling the language server for ${duration}s. Reproduce the slow behaviour now`
+      );
+    })
+  );
+
   const startSourcemapGenerationForAllFolders = () => {
     if (vscode.workspace.workspaceFolders) {
       for (const folder of vscode.workspace.workspaceFolders) {
@@ -2,6 +2,8 @@
 #include "Analyze/AnalyzeCli.hpp"
 #include "Analyze/CliConfigurationParser.hpp"
 #include "Analyze/CliClient.hpp"
+#include "Analyze/StreamingAnalysis.hpp"
+#include "LSP/DirectoryWalker.hpp"
 
 #include "Luau/ModuleResolver.h"
 #include "Luau/BuiltinDefinitions.h"
@@ -80,7 +82,7 @@ static bool reportError(
 
     std::string humanReadableName = fileResolver->getHumanReadableModuleName(errorFriendlyName);
 
-    if (isIgnoredFile(rootUriPath, *path, ignoreGlobPatterns))
+    if (isIgnoredFile(rootUriPath, *path, ignoreGlobPatterns) || fileResolver->isPackageFile(*path))
         return false;
 
     if (const auto* syntaxError = Luau::get_if<Luau::SyntaxError>(&error.data))
@@ -143,9 +145,11 @@ int startAnalyze(int argc, char** argv)
 {
     ReportFormat format = ReportFormat::Default;
     bool annotate = false;
+    bool stream = false;
     std::optional<std::filesystem::path> sourcemapPath = std::nullopt;
     std::vector<std::filesystem::path> definitionsPaths{};
     std::vector<std::filesystem::path> files{};
+    std::vector<std::filesystem::path> directories{};
     std::vector<std::string> ignoreGlobPatterns{};
     std::optional<std::filesystem::path> baseLuaurc = std::nullopt;
     std::optional<std::filesystem::path> settingsPath = std::nullopt;
@@ -164,6 +168,8 @@ int startAnalyze(int argc, char** argv)
                 annotate = true;
             else if (strcmp(argv[i], "--timetrace") == 0)
                 FFlag::DebugLuauTimeTracing.value = true;
+            else if (strcmp(argv[i], "--stream") == 0)
+                stream = true;
             else if (strcmp(argv[i], "--no-strict-dm-types") == 0)
                 expressiveTypes = false;
             else if (strncmp(argv[i], "--sourcemap=", 12) == 0)
@@ -195,24 +201,11 @@ int startAnalyze(int argc, char** argv)
             }
 
 
+            // Directories are searched once all the options are known
             if (std::filesystem::is_directory(path))
-            {
-                for (std::filesystem::recursive_directory_iterator next(path), end; next != end; ++next)
-                {
-                    if (next->is_regular_file() && next->path().has_extension())
-                    {
-                        auto ext = next->path().extension();
-                        if (ext == ".lua" || ext == ".luau")
-                        {
-                            files.push_back(next->path());
-                        }
-                    }
-                }
-            }
+                directories.push_back(path);
             else
-            {
                 files.push_back(path);
-            }
         }
     }
 
@@ -224,6 +217,13 @@ int startAnalyze(int argc, char** argv)
     }
 #endif
 
+    // Annotating requires the syntax tree and full type graph of every module, which streaming releases
+    if (stream && annotate)
+    {
+        fprintf(stderr, "--stream cannot be used with --annotate\n");
+        return 1;
+    }
+
     // Check if files exist
     if (sourcemapPath.has_value() && !std::filesystem::exists(sourcemapPath.value()))
     {
@@ -237,12 +237,6 @@ int startAnalyze(int argc, char** argv)
         return 1;
     }
 
-    if (files.empty())
-    {
-        fprintf(stderr, "error: no files provided\n");
-        return 1;
-    }
-
     // Setup Frontend
     Luau::FrontendOptions frontendOptions;
     frontendOptions.retainFullTypeGraphs = annotate;
@@ -272,6 +266,28 @@ int startAnalyze(int argc, char** argv)
         }
     }
 
+    // Find all source files in the provided directories, skipping over any ignored directories
+    // Ignore globs are relative to the current directory, whilst the `.gitignore` file is read from each directory being analyzed
+    auto currentPath = std::filesystem::current_path();
+    GlobSet ignoreGlobs(ignoreGlobPatterns);
+    for (const auto& directory : directories)
+    {
+        DirectoryWalkRules walkRules{currentPath, ignoreGlobs,
+            GlobSet(client.configuration.respectGitignore ? readGitignoreGlobs(directory) : std::vector<std::string>{}), directory};
+        walkSourceFiles(directory, walkRules,
+            [&files](const std::filesystem::path& path)
+            {
+                files.push_back(path);
+                return true;
+            });
+    }
+
+    if (files.empty())
+    {
+        fprintf(stderr, "error: no files provided\n");
+        return 1;
+    }
+
 
     WorkspaceFileResolver fileResolver;
     if (baseLuaurc)
@@ -347,15 +363,45 @@ int startAnalyze(int argc, char** argv)
         }
     }
 
-    types::registerInstanceTypes(frontend, frontend.globals, frontend.globals.globalTypes, fileResolver, expressiveTypes);
+    types::DeferredInstanceChildren deferredInstanceChildren;
+    types::registerInstanceTypes(frontend, frontend.globals, frontend.globals.globalTypes, fileResolver, deferredInstanceChildren, expressiveTypes);
 
     Luau::freeze(frontend.globals.globalTypes);
     Luau::freeze(frontend.globalsForAutocomplete.globalTypes);
 
     int failed = 0;
 
-    for (const std::filesystem::path& path : files)
-        failed += !analyzeFile(frontend, path, format, annotate, ignoreGlobPatterns);
+    if (stream)
+    {
+        // Check files in dependency order, so that each module can be released as soon as every module requiring it has been checked.
+        // Peak memory then grows with the widest layer of the require graph rather than with the number of files
+        auto graph = scanDependencyGraph(fileResolver, files);
+
+        std::vector<std::filesystem::path> ordered;
+        for (const std::filesystem::path& path : orderByDependencies(files, graph))
+        {
+            // Package files are only checked when they are required by other files, to produce their types
+            if (!fileResolver.isPackageFile(path, client.configuration))
+                ordered.push_back(path);
+        }
+
+        StreamingReleaser releaser(frontend, graph, ordered);
+        for (const std::filesystem::path& path : ordered)
+        {
+            failed += !analyzeFile(frontend, path, format, annotate, ignoreGlobPatterns);
+            releaser.markChecked(path.generic_string());
+        }
+    }
+    else
+    {
+        for (const std::filesystem::path& path : files)
+        {
+            // Package files are only checked when they are required by other files, to produce their types
+            if (fileResolver.isPackageFile(path, client.configuration))
+                continue;
+            failed += !analyzeFile(frontend, path, format, annotate, ignoreGlobPatterns);
+        }
+    }
 
     if (!client.diagnostics.empty())
     {
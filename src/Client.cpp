@@ -1,8 +1,18 @@
 #include "LSP/Client.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 void Client::sendRequest(
     const id_type& id, const std::string& method, const std::optional<json>& params, const std::optional<ResponseHandler>& handler)
 {
@@ -188,6 +198,41 @@ bool Client::readRawMessage(std::string& output)
     return json_rpc::readRawMessage(std::cin, output);
 }
 
+bool Client::hasPendingMessage()
+{
+    return waitForMessage(std::chrono::milliseconds(0));
+}
+
+bool Client::waitForMessage(std::chrono::milliseconds timeout)
+{
+    // Input which has already been read into the stream buffer. This relies on `std::cin` buffering its own input, which is only the case
+    // once it is no longer synchronised with C stdio (see main). Otherwise, input buffered by C stdio is invisible to both checks
+    if (json_rpc::hasBufferedInput(std::cin))
+        return true;
+
+    // Otherwise, check whether the client has written anything we have not yet read. The end of the input also counts,
+    // so that the input loop can notice that the client has gone away
+#ifdef _WIN32
+    // Pipes cannot be waited on, so we check periodically until the timeout passes
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true)
+    {
+        DWORD available = 0;
+        if (!PeekNamedPipe(GetStdHandle(STD_INPUT_HANDLE), nullptr, 0, nullptr, &available, nullptr))
+            return GetLastError() == ERROR_BROKEN_PIPE;
+        if (available > 0)
+            return true;
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        Sleep(10);
+    }
+#else
+    pollfd input{STDIN_FILENO, POLLIN, 0};
+    return poll(&input, 1, static_cast<int>(std::max<std::chrono::milliseconds::rep>(timeout.count(), 0))) > 0 &&
+           (input.revents & (POLLIN | POLLHUP)) != 0;
+#endif
+}
+
 void Client::handleResponse(const JsonRpcMessage& message)
 {
     // We run our own exception catcher here because we don't want an exception escaping
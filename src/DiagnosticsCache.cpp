@@ -0,0 +1,91 @@
+#include "LSP/DiagnosticsCache.hpp"
+#include "LSP/Utils.hpp"
+
+#include <fstream>
+
+/// Bumped whenever the format of the cache (or the diagnostics we produce) changes, to invalidate old caches
+static constexpr int CACHE_FORMAT_VERSION = 1;
+
+void DiagnosticsCache::load(const std::filesystem::path& cachePath)
+{
+    path = cachePath;
+    environmentHash.clear();
+    entries.clear();
+    updated.clear();
+
+    auto contents = readFile(cachePath);
+    if (!contents)
+        return;
+
+    try
+    {
+        auto data = json::parse(*contents);
+        if (data.value("version", 0) != CACHE_FORMAT_VERSION)
+            return;
+
+        environmentHash = data.at("environmentHash").get<std::string>();
+        entries = data.at("modules").get<std::unordered_map<std::string, CachedDiagnostics>>();
+    }
+    catch (const std::exception&)
+    {
+        // The cache is corrupt, so we start again from scratch
+        environmentHash.clear();
+        entries.clear();
+    }
+}
+
+std::optional<CachedDiagnostics> DiagnosticsCache::take(const std::string& moduleName, const std::string& currentEnvironmentHash)
+{
+    if (environmentHash != currentEnvironmentHash)
+        return std::nullopt;
+
+    auto it = entries.find(moduleName);
+    if (it == entries.end())
+        return std::nullopt;
+
+    auto entry = std::move(it->second);
+    entries.erase(it);
+    return entry;
+}
+
+void DiagnosticsCache::record(const std::string& moduleName, const std::vector<lsp::Diagnostic>& diagnostics)
+{
+    if (isEnabled())
+        updated.insert_or_assign(moduleName, diagnostics);
+}
+
+bool DiagnosticsCache::save(const std::string& currentEnvironmentHash, const std::function<std::optional<ModuleHashes>(const std::string&)>& computeHashes)
+{
+    if (!path)
+        return false;
+
+    // Entries from a previous session computed in a different environment may no longer be valid
+    if (environmentHash != currentEnvironmentHash)
+    {
+        environmentHash = currentEnvironmentHash;
+        entries.clear();
+    }
+
+    for (auto& [moduleName, diagnostics] : updated)
+    {
+        if (auto hashes = computeHashes(moduleName))
+            entries.insert_or_assign(moduleName, CachedDiagnostics{hashes->contentHash, hashes->dependencyHash, std::move(diagnostics)});
+        else
+            entries.erase(moduleName);
+    }
+    updated.clear();
+
+    json data;
+    data["version"] = CACHE_FORMAT_VERSION;
+    data["environmentHash"] = environmentHash;
+    data["modules"] = entries;
+
+    std::error_code ec;
+    std::filesystem::create_directories(path->parent_path(), ec);
+
+    std::ofstream file(*path, std::ios::out | std::ios::trunc);
+    if (!file)
+        return false;
+    file << data.dump();
+    return file.good();
+}
@@ -0,0 +1,169 @@
+#include "LSP/DirectoryInventory.hpp"
+#include "LSP/Utils.hpp"
+
+// As windows/macOS is case-insensitive, paths are looked up by their lowercased names, matching `WorkspaceFileResolver::normalisedUriString`
+static std::string normaliseName(const std::filesystem::path& part)
+{
+    auto name = part.generic_string();
+#if defined(_WIN32) || defined(__APPLE__)
+    name = toLower(name);
+#endif
+    return name;
+}
+
+static bool isSourceFile(const std::filesystem::path& path)
+{
+    return path.extension() == ".lua" || path.extension() == ".luau";
+}
+
+std::optional<std::map<std::string, DirectoryInventory::Node>> DirectoryInventory::readChildren(const std::filesystem::path& directory)
+{
+    std::map<std::string, Node> children;
+    try
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            auto name = entry.path().filename().generic_string();
+            if (entry.is_directory())
+                children.emplace(normaliseName(entry.path().filename()), Node{name});
+            else if (entry.is_regular_file() && isSourceFile(entry.path()))
+                children.emplace(normaliseName(entry.path().filename()), Node{name, /* isDirectory: */ false});
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+
+    return children;
+}
+
+std::vector<DirectoryInventory::Entry> DirectoryInventory::toEntries(const std::map<std::string, Node>& children)
+{
+    std::vector<Entry> entries;
+    entries.reserve(children.size());
+    for (const auto& [_, child] : children)
+        entries.push_back(Entry{child.name, child.isDirectory});
+    return entries;
+}
+
+std::optional<std::vector<DirectoryInventory::Entry>> DirectoryInventory::read(const std::filesystem::path& directory)
+{
+    if (auto children = readChildren(directory))
+        return toEntries(*children);
+    return std::nullopt;
+}
+
+std::optional<std::vector<DirectoryInventory::Entry>> DirectoryInventory::list(const std::filesystem::path& directory)
+{
+    // Find the deepest node along the path which is already known. Nodes are only added once the directory has been read,
+    // so that listing a missing directory does not make it appear in the listing of its parent
+    auto normalised = directory.lexically_normal();
+    auto* node = &root;
+    auto it = normalised.begin();
+    for (; it != normalised.end(); ++it)
+    {
+        if (it->empty())
+            continue;
+
+        auto child = node->children.find(normaliseName(*it));
+        if (child == node->children.end())
+            break;
+        if (!child->second.isDirectory)
+            return std::nullopt;
+        node = &child->second;
+    }
+
+    if (it != normalised.end() || !node->listed)
+    {
+        directoryReadCount += 1;
+        auto children = readChildren(directory);
+        if (!children)
+        {
+            // The directory may be created later, so we do not remember that it could not be read
+            return std::nullopt;
+        }
+
+        // The directory exists, so any ancestors which were not yet known do too
+        for (; it != normalised.end(); ++it)
+        {
+            if (it->empty())
+                continue;
+            node = &node->children.try_emplace(normaliseName(*it), Node{it->generic_string()}).first->second;
+        }
+
+        // Keep any subdirectories which have already been listed
+        for (auto& [key, child] : *children)
+        {
+            if (auto existing = node->children.find(key); child.isDirectory && existing != node->children.end() && existing->second.isDirectory)
+            {
+                existing->second.name = child.name;
+                child = std::move(existing->second);
+            }
+        }
+
+        node->children = std::move(*children);
+        node->listed = true;
+    }
+
+    return toEntries(node->children);
+}
+
+void DirectoryInventory::created(const std::filesystem::path& path, bool isDirectory)
+{
+    if (!isDirectory && !isSourceFile(path))
+        return;
+
+    auto normalised = path.lexically_normal();
+    auto* node = &root;
+    for (auto it = normalised.begin(); it != normalised.end(); ++it)
+    {
+        if (it->empty())
+            continue;
+
+        auto key = normaliseName(*it);
+        auto child = node->children.find(key);
+        if (child == node->children.end())
+        {
+            // The contents of an unlisted directory will be read from disk once it is listed
+            if (!node->listed)
+                return;
+
+            // Any missing ancestors of the path were created along with it
+            bool isLast = std::next(it) == normalised.end();
+            child = node->children.emplace(key, Node{it->generic_string(), /* isDirectory: */ !isLast || isDirectory, /* listed: */ !isLast}).first;
+        }
+
+        node = &child->second;
+        if (!node->isDirectory)
+            return;
+    }
+}
+
+void DirectoryInventory::deleted(const std::filesystem::path& path)
+{
+    auto normalised = path.lexically_normal();
+    auto* node = &root;
+    std::string key;
+    for (const auto& part : normalised)
+    {
+        if (part.empty())
+            continue;
+
+        if (!key.empty())
+        {
+            auto child = node->children.find(key);
+            if (child == node->children.end())
+                return;
+            node = &child->second;
+        }
+        key = normaliseName(part);
+    }
+
+    node->children.erase(key);
+}
+
+void DirectoryInventory::clear()
+{
+    root = Node{};
+}
@@ -0,0 +1,87 @@
+#include "LSP/DirectoryWalker.hpp"
+#include "LSP/Utils.hpp"
+#include "glob/glob.hpp"
+
+GlobSet::GlobSet(const std::vector<std::string>& globs)
+{
+    patterns.reserve(globs.size());
+    for (const auto& glob : globs)
+        patterns.emplace_back(glob::compile_pattern(glob));
+}
+
+bool GlobSet::matches(const std::string& path) const
+{
+    for (const auto& pattern : patterns)
+        if (std::regex_match(path, pattern))
+            return true;
+    return false;
+}
+
+std::vector<std::string> readGitignoreGlobs(const std::filesystem::path& root)
+{
+    std::vector<std::string> globs{};
+
+    auto contents = readFile(root / ".gitignore");
+    if (!contents)
+        return globs;
+
+    std::istringstream stream(*contents);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        if (line[0] == '!')
+            return {};
+
+        // Directory-only rules are treated the same as any other rule
+        if (line.back() == '/')
+            line.pop_back();
+
+        // A rule containing a separator is relative to the root, otherwise it can match at any level
+        bool anchored = line.find('/') != std::string::npos;
+        if (line[0] == '/')
+            line.erase(0, 1);
+
+        if (line.empty())
+            continue;
+
+        globs.push_back(line);
+        if (!anchored)
+            globs.push_back("**/" + line);
+    }
+
+    return globs;
+}
+
+void walkSourceFiles(
+    const std::filesystem::path& directory, const DirectoryWalkRules& rules, const std::function<bool(const std::filesystem::path&)>& callback)
+{
+    for (std::filesystem::recursive_directory_iterator next(directory), end; next != end; ++next)
+    {
+        // HACK: we convert to generic string so we get '/' separators
+        // Paths provided relative to the current directory (e.g. from the command line) are matched as is
+        const auto& path = next->path();
+        auto relativePath = (path.is_absolute() ? path.lexically_relative(rules.root) : path.lexically_normal()).generic_string();
+        auto gitignorePath = rules.gitignoreRoot.empty()
+                                 ? relativePath
+                                 : std::filesystem::absolute(path).lexically_relative(rules.gitignoreRoot).generic_string();
+
+        if (next->is_directory())
+        {
+            if (next->path().filename() == ".git" || rules.gitignoreGlobs.matches(gitignorePath) || rules.ignoreGlobs.matches(relativePath + "/"))
+                next.disable_recursion_pending();
+            continue;
+        }
+
+        if (next->is_regular_file() && next->path().has_extension())
+        {
+            auto ext = next->path().extension();
+            if ((ext == ".lua" || ext == ".luau") && !rules.gitignoreGlobs.matches(gitignorePath))
+                if (!callback(next->path()))
+                    return;
+        }
+    }
+}
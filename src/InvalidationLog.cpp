@@ -0,0 +1,106 @@
+#include "LSP/InvalidationLog.hpp"
+
+#include <algorithm>
+
+static std::string describeCause(InvalidationCause cause)
+{
+    switch (cause)
+    {
+    case InvalidationCause::DocumentOpened:
+        return "document opened";
+    case InvalidationCause::DocumentChanged:
+        return "document changed";
+    case InvalidationCause::DocumentClosed:
+        return "document closed";
+    case InvalidationCause::FileChanged:
+        return "file changed";
+    case InvalidationCause::FileRenamed:
+        return "file renamed";
+    case InvalidationCause::SourcemapChanged:
+        return "sourcemap changed";
+    case InvalidationCause::ConfigurationChanged:
+        return "configuration changed";
+    case InvalidationCause::StudioPluginChanged:
+        return "studio plugin changed";
+    case InvalidationCause::TypeGraphNotRetained:
+        return "type graph not retained";
+    case InvalidationCause::InterfaceStubReleased:
+        return "interface stub released";
+    }
+
+    return "unknown";
+}
+
+template<typename T>
+static void pushBounded(std::deque<T>& records, T record, size_t limit)
+{
+    records.push_back(std::move(record));
+    while (records.size() > limit)
+        records.pop_front();
+}
+
+Invalidation InvalidationLog::begin(InvalidationCause cause, const Luau::ModuleName& root, size_t moduleCount)
+{
+    Invalidation invalidation{nextSequence++, cause, root, moduleCount};
+    pushBounded(recentInvalidations, invalidation, MAX_RECENT_INVALIDATIONS);
+    return invalidation;
+}
+
+void InvalidationLog::record(InvalidationCause cause, const Luau::ModuleName& root, const std::vector<Luau::ModuleName>& invalidated)
+{
+    if (invalidated.empty())
+        return;
+
+    auto invalidation = begin(cause, root, invalidated.size());
+    for (const auto& moduleName : invalidated)
+        pushBounded(moduleInvalidations[moduleName], invalidation, MAX_RECORDS_PER_MODULE);
+}
+
+void InvalidationLog::recordWorkspace(InvalidationCause cause)
+{
+    // Every module is affected, so we record this once rather than against each module
+    auto invalidation = begin(cause, "", 0);
+    pushBounded(workspaceInvalidations, invalidation, MAX_RECORDS_PER_MODULE);
+}
+
+std::vector<Invalidation> InvalidationLog::forModule(const Luau::ModuleName& moduleName) const
+{
+    std::vector<Invalidation> result{workspaceInvalidations.begin(), workspaceInvalidations.end()};
+    if (auto it = moduleInvalidations.find(moduleName); it != moduleInvalidations.end())
+        result.insert(result.end(), it->second.begin(), it->second.end());
+
+    std::sort(result.begin(), result.end(),
+        [](const Invalidation& a, const Invalidation& b)
+        {
+            return a.sequence < b.sequence;
+        });
+
+    if (result.size() > MAX_RECORDS_PER_MODULE)
+        result.erase(result.begin(), result.end() - MAX_RECORDS_PER_MODULE);
+    return result;
+}
+
+std::optional<Invalidation> InvalidationLog::latest(const Luau::ModuleName& moduleName) const
+{
+    std::optional<Invalidation> result = std::nullopt;
+    if (!workspaceInvalidations.empty())
+        result = workspaceInvalidations.back();
+
+    if (auto it = moduleInvalidations.find(moduleName); it != moduleInvalidations.end() && !it->second.empty())
+        if (!result || it->second.back().sequence > result->sequence)
+            result = it->second.back();
+
+    return result;
+}
+
+std::string describeCheckedModule(const InvalidationLog& log, const Luau::ModuleName& moduleName)
+{
+    auto invalidation = log.latest(moduleName);
+    if (!invalidation)
+        return moduleName;
+
+    auto description = moduleName + " (" + describeCause(invalidation->cause);
+    if (!invalidation->root.empty() && invalidation->root != moduleName)
+        description += " in " + invalidation->root;
+    return description + ")";
+}
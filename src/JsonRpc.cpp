@@ -114,6 +114,11 @@ bool readRawMessage(std::istream& input, std::string& output)
 }
 
 /// Sends a raw JSON-RPC message to output stream
+bool hasBufferedInput(std::istream& input)
+{
+    return input.rdbuf()->in_avail() > 0;
+}
+
 void sendRawMessage(std::ostream& output, const json& message)
 {
     std::string s = message.dump();
@@ -4,9 +4,11 @@
 #include <variant>
 #include <exception>
 #include <algorithm>
+#include <unordered_set>
 
 #include "LSP/Uri.hpp"
 #include "LSP/DocumentationParser.hpp"
+#include "LSP/RequestTrace.hpp"
 
 #define ASSERT_PARAMS(params, method) \
     if (!params) \
@@ -16,12 +18,14 @@
     (!(params) ? throw json_rpc::JsonRpcException(lsp::ErrorCode::InvalidParams, "params not provided for " method) : (params).value())
 
 LanguageServer::LanguageServer(const std::vector<std::filesystem::path>& definitionsFiles,
-    const std::vector<std::filesystem::path>& documentationFiles, std::optional<Luau::Config> defaultConfig)
+    const std::vector<std::filesystem::path>& documentationFiles, std::optional<Luau::Config> defaultConfig,
+    std::optional<std::filesystem::path> cacheDirectory)
     : client(std::make_shared<Client>())
     , defaultConfig(std::move(defaultConfig))
 {
     client->definitionsFiles = definitionsFiles;
     client->documentationFiles = documentationFiles;
+    client->cacheDirectory = std::move(cacheDirectory);
     parseDocumentation(documentationFiles, client->documentation, client);
     nullWorkspace = std::make_shared<WorkspaceFolder>(client, "$NULL_WORKSPACE", Uri(), defaultConfig);
 }
@@ -65,7 +69,9 @@ WorkspaceFolderPtr LanguageServer::findWorkspace(const lsp::DocumentUri& file)
 lsp::ServerCapabilities LanguageServer::getServerCapabilities()
 {
     lsp::ServerCapabilities capabilities;
-    capabilities.textDocumentSync = lsp::TextDocumentSyncKind::Incremental;
+    // Save notifications are used to recheck dependents when they are deferred until save
+    capabilities.textDocumentSync = lsp::TextDocumentSyncOptions{
+        /* openClose: */ true, /* change: */ lsp::TextDocumentSyncKind::Incremental, /* save: */ lsp::SaveOptions{/* includeText: */ false}};
     // Completion
     std::vector<std::string> completionTriggerCharacters{".", ":", "'", "\"", "/", "\n"}; // \n is used to trigger end completion
     lsp::CompletionOptions::CompletionItem completionItem{/* labelDetailsSupport: */ true};
@@ -116,11 +122,32 @@ lsp::ServerCapabilities LanguageServer::getServerCapabilities()
     };
     // Workspaces
     lsp::WorkspaceFoldersServerCapabilities workspaceFolderCapabilities{true, false};
-    capabilities.workspace = lsp::WorkspaceCapabilities{workspaceFolderCapabilities};
+    // Renamed files (and folders containing them) are remapped to their new module names
+    lsp::FileOperationRegistrationOptions renameRegistration{{
+        {"file", {"**/*.{lua,luau}", lsp::FileOperationPatternKind::File}},
+        {"file", {"**", lsp::FileOperationPatternKind::Folder}},
+    }};
+    // The file watcher only reports source files, so created and deleted folders are used to keep directory listings current
+    lsp::FileOperationRegistrationOptions folderRegistration{{
+        {"file", {"**", lsp::FileOperationPatternKind::Folder}},
+    }};
+    capabilities.workspace = lsp::WorkspaceCapabilities{
+        workspaceFolderCapabilities, lsp::FileOperationOptions{renameRegistration, folderRegistration, folderRegistration}};
     return capabilities;
 }
 
-void LanguageServer::onRequest(const id_type& id, const std::string& method, std::optional<json> baseParams)
+// Maximum number of responses kept for reuse by duplicate requests
+static constexpr size_t MAX_RECENT_RESPONSES = 64;
+
+/// Whether the request only reads server state, so that duplicate requests will produce the same response
+static bool isReusableRequest(const std::string& method)
+{
+    return method == "textDocument/hover" || method == "textDocument/semanticTokens/full" || method == "textDocument/documentSymbol" ||
+           method == "textDocument/documentLink" || method == "textDocument/documentColor" || method == "textDocument/inlayHint" ||
+           method == "textDocument/foldingRange" || method == "textDocument/diagnostic";
+}
+
+void LanguageServer::onRequest(const id_type& id, const std::string& method, std::optional<json> baseParams, tracing::Clock::duration queueTime)
 {
     // Handle request
     // If a request has been sent before the server is initialized, we should error
@@ -130,8 +157,26 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     if (shutdownRequested)
         throw JsonRpcException(lsp::ErrorCode::InvalidRequest, "server is shutting down");
 
+    // If an identical request has been handled since the server state was last modified, reuse its response
+    std::optional<std::string> requestKey = std::nullopt;
+    if (baseParams && isReusableRequest(method))
+    {
+        requestKey = method + ':' + baseParams->dump();
+        if (auto it = recentResponses.find(*requestKey); it != recentResponses.end())
+        {
+            client->sendResponse(id, it->second);
+            return;
+        }
+    }
+
+    tracing::RequestTrace trace{method, queueTime};
+    tracing::ScopedRequestTrace scopedTrace{trace};
+
     Response response;
 
+    // Time spent in the handler outside of any nested spans is the handler's own work (e.g. visiting the AST)
+    trace.beginSpan("handler");
+
     if (method == "initialize")
     {
         response = onInitialize(REQUIRED_PARAMS(baseParams, "initialize"));
@@ -166,7 +211,14 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     }
     else if (method == "textDocument/references")
     {
-        response = references(REQUIRED_PARAMS(baseParams, "textDocument/references"));
+        ASSERT_PARAMS(baseParams, "textDocument/references")
+        auto params = baseParams->get<lsp::ReferenceParams>();
+        scheduleRequest(id, std::move(trace), baseParams,
+            [this, params]()
+            {
+                return references(params);
+            });
+        return;
     }
     else if (method == "textDocument/rename")
     {
@@ -211,8 +263,12 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     {
         ASSERT_PARAMS(baseParams, "callHierarchy/incomingCalls")
         auto params = baseParams->get<lsp::CallHierarchyIncomingCallsParams>();
-        auto workspace = findWorkspace(params.item.uri);
-        response = workspace->callHierarchyIncomingCalls(params);
+        scheduleRequest(id, std::move(trace), baseParams,
+            [this, params]()
+            {
+                return findWorkspace(params.item.uri)->resumableCallHierarchyIncomingCalls(params);
+            });
+        return;
     }
     else if (method == "callHierarchy/outgoingCalls")
     {
@@ -236,36 +292,181 @@ void LanguageServer::onRequest(const id_type& id, const std::string& method, std
     {
         // This request has partial request support.
         // If workspaceDiagnostic returns nothing, then we don't signal a response (as data will be sent as progress notifications)
-        if (auto report = workspaceDiagnostic(REQUIRED_PARAMS(baseParams, "workspace/diagnostic")))
-        {
-            response = report;
-        }
-        else
-        {
-            client->workspaceDiagnosticsRequestId = id;
-            return;
-        }
+        ASSERT_PARAMS(baseParams, "workspace/diagnostic")
+        auto params = baseParams->get<lsp::WorkspaceDiagnosticParams>();
+        scheduleRequest(
+            id, std::move(trace), baseParams,
+            [this, params]()
+            {
+                return workspaceDiagnostic(params);
+            },
+            [this, id](lsp::PartialResponse<lsp::WorkspaceDiagnosticReport>&& result)
+            {
+                if (result)
+                    client->sendResponse(id, *result);
+                else
+                    client->workspaceDiagnosticsRequestId = id;
+            });
+        return;
+    }
+    else if (method == "luau-lsp/profile")
+    {
+        response = profile(REQUIRED_PARAMS(baseParams, "luau-lsp/profile"));
+    }
+    else if (method == "luau-lsp/invalidations")
+    {
+        response = invalidations(REQUIRED_PARAMS(baseParams, "luau-lsp/invalidations"));
     }
     else if (method == "workspace/symbol")
     {
         ASSERT_PARAMS(baseParams, "workspace/symbol")
         auto params = baseParams->get<lsp::WorkspaceSymbolParams>();
-
-        std::vector<lsp::WorkspaceSymbol> result;
-        for (auto& workspace : workspaceFolders)
-        {
-            auto report = workspace->workspaceSymbol(params);
-            if (report)
-                result.insert(result.end(), std::make_move_iterator(report->begin()), std::make_move_iterator(report->end()));
-        }
-        response = result;
+        scheduleRequest(id, std::move(trace), baseParams,
+            [this, params]()
+            {
+                return workspaceSymbol(params);
+            });
+        return;
     }
     else
     {
         throw JsonRpcException(lsp::ErrorCode::MethodNotFound, "method not found / supported: " + method);
     }
 
-    client->sendResponse(id, response);
+    trace.endSpan();
+
+    if (requestKey)
+    {
+        if (recentResponses.size() >= MAX_RECENT_RESPONSES)
+            recentResponses.clear();
+        recentResponses.emplace(*requestKey, response);
+    }
+
+    {
+        tracing::ScopedSpan span("serialize response");
+        client->sendResponse(id, response);
+    }
+
+    reportSlowRequest(trace, baseParams);
+}
+
+Resumable<std::vector<lsp::WorkspaceSymbol>> LanguageServer::workspaceSymbol(const lsp::WorkspaceSymbolParams& params)
+{
+    std::vector<Resumable<std::vector<lsp::WorkspaceSymbol>>> searches;
+    searches.reserve(workspaceFolders.size());
+    for (auto& workspace : workspaceFolders)
+        searches.push_back(workspace->resumableWorkspaceSymbol(params));
+
+    return sequence(std::move(searches), std::vector<lsp::WorkspaceSymbol>{},
+        [](std::vector<lsp::WorkspaceSymbol>& result, std::vector<lsp::WorkspaceSymbol>&& symbols)
+        {
+            result.insert(result.end(), std::make_move_iterator(symbols.begin()), std::make_move_iterator(symbols.end()));
+        });
+}
+
+/// Queues a request whose handler yields between units of work. `start` creates the handler, and is called again if the request is restarted.
+/// Once the handler completes, its result is passed to `complete` and the request's trace is reported, as for any other request
+template<typename Start, typename Complete>
+void LanguageServer::scheduleRequest(const id_type& id, tracing::RequestTrace trace, std::optional<json> params, Start start, Complete complete)
+{
+    auto sharedTrace = std::make_shared<tracing::RequestTrace>(std::move(trace));
+    requestScheduler.schedule(id,
+        [this, sharedTrace, params = std::move(params), start = std::move(start), complete = std::move(complete)]()
+        {
+            tracing::ScopedRequestTrace scopedTrace{*sharedTrace};
+            return RequestScheduler::ResumeFunction{[this, sharedTrace, params, resumable = start(), complete]()
+                {
+                    tracing::ScopedRequestTrace scopedTrace{*sharedTrace};
+                    auto result = resumable();
+                    if (!result)
+                        return false;
+
+                    sharedTrace->endSpan();
+                    {
+                        tracing::ScopedSpan span("serialize response");
+                        complete(std::move(*result));
+                    }
+
+                    reportSlowRequest(*sharedTrace, params);
+                    return true;
+                }};
+        });
+}
+
+/// Queues a request whose handler yields between units of work, sending its result as the response once the handler completes
+template<typename Start>
+void LanguageServer::scheduleRequest(const id_type& id, tracing::RequestTrace trace, std::optional<json> params, Start start)
+{
+    scheduleRequest(id, std::move(trace), std::move(params), std::move(start),
+        [this, id](auto&& result)
+        {
+            client->sendResponse(id, result);
+        });
+}
+
+/// Performs the next unit of work of a pending request. If the handler fails, the error is sent in place of its response
+void LanguageServer::resumePendingRequest()
+{
+    auto id = requestScheduler.nextId();
+    try
+    {
+        requestScheduler.resumeNext();
+    }
+    catch (const JsonRpcException& e)
+    {
+        client->sendError(id, e);
+    }
+    catch (const json::exception& e)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::ParseError, e.what()));
+    }
+    catch (const std::exception& e)
+    {
+        client->sendError(id, JsonRpcException(lsp::ErrorCode::InternalError, e.what()));
+    }
+}
+
+/// Drops every pending request, as the state they have accumulated so far (e.g. types found in a module) may no longer be valid
+void LanguageServer::cancelPendingRequests(lsp::ErrorCode code, const std::string& reason)
+{
+    for (const auto& id : requestScheduler.cancelAll())
+        client->sendError(id, JsonRpcException(code, reason));
+}
+
+/// Writes the span breakdown of the request to the log if it took longer than the configured threshold,
+/// so that stalls can be diagnosed without needing to be reproduced
+void LanguageServer::reportSlowRequest(tracing::RequestTrace& trace, const std::optional<json>& params)
+{
+    // This runs after the response has been sent, so an error here must not escape and cause a second response for the same request
+    try
+    {
+        auto duration = trace.finish() + trace.getQueueTime();
+
+        std::optional<lsp::DocumentUri> uri = std::nullopt;
+        if (params && params->is_object() && params->contains("textDocument") && params->at("textDocument").contains("uri"))
+            uri = params->at("textDocument").at("uri").get<lsp::DocumentUri>();
+
+        auto workspace = uri ? findWorkspace(*uri) : nullWorkspace;
+        auto threshold = std::chrono::milliseconds(client->getConfiguration(workspace->rootUri).debug.slowRequestThreshold);
+        if (threshold.count() == 0 || duration < threshold)
+            return;
+
+        std::string context;
+        if (uri)
+        {
+            context += " [module: " + workspace->fileResolver.getModuleName(*uri);
+            if (auto textDocument = workspace->fileResolver.getTextDocument(*uri))
+                context += ", version: " + std::to_string(textDocument->version());
+            context += "]";
+        }
+
+        client->sendLogMessage(lsp::MessageType::Warning,
+            "Slow request (exceeded " + std::to_string(threshold.count()) + "ms threshold)" + context + ": " + trace.format());
+    }
+    catch (const std::exception& e)
+    {
+        client->sendLogMessage(lsp::MessageType::Error, std::string("failed to report slow request: ") + e.what());
+    }
 }
 
 void LanguageServer::onNotification(const std::string& method, std::optional<json> params)
@@ -276,6 +477,13 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
     if ((!isInitialized || shutdownRequested) && method != "exit")
         return;
 
+    // Any other notification may modify server state, so previous responses can no longer be reused, and pending requests must restart
+    if (method != "$/setTrace" && method != "$/cancelRequest")
+    {
+        recentResponses.clear();
+        requestScheduler.restartAll();
+    }
+
     if (method == "exit")
     {
         // Exit the process loop
@@ -291,8 +499,12 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
     }
     else if (method == "$/cancelRequest")
     {
-        // NO-OP
-        // TODO: support cancellation
+        // Only requests which are still pending can be cancelled, as every other request is handled as soon as it is received
+        ASSERT_PARAMS(params, "$/cancelRequest")
+        const auto& requestId = params->at("id");
+        id_type id = requestId.is_string() ? id_type(requestId.get<std::string>()) : id_type(requestId.get<int>());
+        if (requestScheduler.cancel(id))
+            client->sendError(id, JsonRpcException(lsp::ErrorCode::RequestCancelled, "request cancelled"));
     }
     else if (method == "textDocument/didOpen")
     {
@@ -304,7 +516,7 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
     }
     else if (method == "textDocument/didSave")
     {
-        // NO-OP
+        onDidSaveTextDocument(REQUIRED_PARAMS(params, "textDocument/didSave"));
     }
     else if (method == "textDocument/didClose")
     {
@@ -322,6 +534,18 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
     {
         onDidChangeWatchedFiles(REQUIRED_PARAMS(params, "workspace/didChangeWatchedFiles"));
     }
+    else if (method == "workspace/didRenameFiles")
+    {
+        onDidRenameFiles(REQUIRED_PARAMS(params, "workspace/didRenameFiles"));
+    }
+    else if (method == "workspace/didCreateFiles")
+    {
+        onDidCreateFiles(REQUIRED_PARAMS(params, "workspace/didCreateFiles"));
+    }
+    else if (method == "workspace/didDeleteFiles")
+    {
+        onDidDeleteFiles(REQUIRED_PARAMS(params, "workspace/didDeleteFiles"));
+    }
     else if (method == "$/plugin/full")
     {
         onStudioPluginFullChange(REQUIRED_PARAMS(params, "$/plugin/full"));
@@ -339,10 +563,29 @@ void LanguageServer::onNotification(const std::string& method, std::optional<jso
 void LanguageServer::processInputLoop()
 {
     std::string jsonString;
+    auto busySince = tracing::Clock::now();
     while (std::cin)
     {
+        // If a message is already waiting before we read it, it arrived whilst we were busy handling previous messages.
+        // We don't know exactly when it arrived, so the time since we were last idle is an upper bound on how long it waited
+        bool queued = Client::hasPendingMessage();
+
+        // Reading blocks until the client sends a message. Whilst a profile is in progress, we only wait until it is due instead,
+        // so that the profile is written when its duration ends even if the client is idle
+        while (!queued && profiler.getDeadline())
+        {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*profiler.getDeadline() - std::chrono::steady_clock::now());
+            if (Client::waitForMessage(remaining))
+                break;
+            pollProfiler();
+        }
+
         if (client->readRawMessage(jsonString))
         {
+            auto receivedAt = tracing::Clock::now();
+            if (!queued)
+                busySince = receivedAt;
+
             // sendTrace(jsonString, std::nullopt);
             std::optional<id_type> id = std::nullopt;
             try
@@ -353,10 +596,14 @@ void LanguageServer::processInputLoop()
 
                 if (msg.is_request())
                 {
-                    onRequest(msg.id.value(), msg.method.value(), msg.params);
+                    onRequest(msg.id.value(), msg.method.value(), msg.params, receivedAt - busySince);
                 }
                 else if (msg.is_response())
                 {
+                    // Responses may update server state (e.g. configuration), so previous responses can no longer be reused,
+                    // and pending requests must restart
+                    recentResponses.clear();
+                    requestScheduler.restartAll();
                     client->handleResponse(msg);
                 }
                 else if (msg.is_notification())
@@ -380,8 +627,67 @@ void LanguageServer::processInputLoop()
             {
                 client->sendError(id, JsonRpcException(lsp::ErrorCode::InternalError, e.what()));
             }
+
+            pollProfiler();
+            enforceMemoryBudget();
+
+            // Resume pending requests until another message is waiting to be processed
+            while (!requestScheduler.empty() && !Client::hasPendingMessage())
+                resumePendingRequest();
+
+            // Only perform background work once every request is complete. We keep going until there is no more work, or until another message
+            // is waiting to be processed, so that the work completes whilst the client is idle
+            while (requestScheduler.empty() && !Client::hasPendingMessage())
+            {
+                if (!processBackgroundWork())
+                    break;
+            }
+        }
+    }
+}
+
+/// Performs deferred work between messages. Each piece of work is bounded by a time budget
+/// so that we remain responsive to any incoming requests
+bool LanguageServer::processBackgroundWork()
+{
+    if (!isInitialized || shutdownRequested)
+        return false;
+
+    bool hasPendingWork = false;
+    for (auto& workspace : workspaceFolders)
+    {
+        auto config = client->getConfiguration(workspace->rootUri);
+        try
+        {
+            // Checking documents which were served provisional diagnostics takes priority, as they are currently being shown to the user.
+            // Any reused responses may now be out of date
+            if (workspace->processDeferredTypeCheck())
+            {
+                recentResponses.clear();
+                return true;
+            }
+
+            if (workspace->processDependentDiagnostics(std::chrono::milliseconds(config.diagnostics.dependentsTimeBudget)))
+            {
+                hasPendingWork = true;
+                continue;
+            }
+
+            // Build the environment used by hover, completion and other features now that diagnostics are up to date,
+            // so that the first of these requests does not have to
+            if (workspace->ensureAutocompleteGlobals())
+                return true;
+
+            // Once there is no more pending work, release any type graphs which are no longer needed
+            workspace->compactTypeGraphs();
+        }
+        catch (const std::exception& e)
+        {
+            client->sendLogMessage(lsp::MessageType::Error, std::string("failed to compute background diagnostics: ") + e.what());
         }
     }
+
+    return hasPendingWork;
 }
 
 bool LanguageServer::requestedShutdown()
@@ -503,11 +809,11 @@ void LanguageServer::onInitialized([[maybe_unused]] const lsp::InitializedParams
     }
 }
 
-void LanguageServer::pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const size_t version)
+void LanguageServer::pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const size_t version, bool allowDeferredTypeCheck)
 {
     // Convert the diagnostics report into a series of diagnostics published for each relevant file
     lsp::DocumentDiagnosticParams params{lsp::TextDocumentIdentifier{uri}};
-    auto diagnostics = workspace->documentDiagnostics(params);
+    auto diagnostics = workspace->documentDiagnostics(params, allowDeferredTypeCheck);
     client->publishDiagnostics(lsp::PublishDiagnosticsParams{uri, version, diagnostics.items});
 
     if (!diagnostics.relatedDocuments.empty())
@@ -522,6 +828,43 @@ void LanguageServer::pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::D
     }
 }
 
+/// Computes and publishes the diagnostics of the dependents of a changed document, along with any related documents already in the report
+void LanguageServer::pushDependentDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri,
+    const std::vector<Luau::ModuleName>& markedDirty, lsp::DocumentDiagnosticReport& diagnostics)
+{
+    auto config = client->getConfiguration(workspace->rootUri);
+    if (config.diagnostics.includeDependents || config.diagnostics.workspace)
+    {
+        for (auto& module : markedDirty)
+        {
+            auto filePath = workspace->fileResolver.resolveToRealPath(module);
+            if (filePath)
+            {
+                auto dependentUri = Uri::file(*filePath);
+                if (dependentUri != uri && !contains(diagnostics.relatedDocuments, dependentUri.toString()) &&
+                    !workspace->isIgnoredFile(*filePath, config) && !workspace->fileResolver.isPackageFile(*filePath, config))
+                {
+                    auto dependencyDiags = workspace->documentDiagnostics(lsp::DocumentDiagnosticParams{{dependentUri}});
+                    diagnostics.relatedDocuments.emplace(dependentUri.toString(),
+                        lsp::SingleDocumentDiagnosticReport{dependencyDiags.kind, dependencyDiags.resultId, dependencyDiags.items});
+                    diagnostics.relatedDocuments.merge(dependencyDiags.relatedDocuments);
+                }
+            }
+        }
+    }
+
+    if (!diagnostics.relatedDocuments.empty())
+    {
+        for (const auto& [relatedUri, relatedDiagnostics] : diagnostics.relatedDocuments)
+        {
+            if (relatedDiagnostics.kind == lsp::DocumentDiagnosticReportKind::Full)
+            {
+                client->publishDiagnostics(lsp::PublishDiagnosticsParams{Uri::parse(relatedUri), std::nullopt, relatedDiagnostics.items});
+            }
+        }
+    }
+}
+
 /// Recompute all necessary diagnostics when we detect a configuration (or sourcemap) change
 void LanguageServer::recomputeDiagnostics(WorkspaceFolderPtr& workspace, const ClientConfiguration& config)
 {
@@ -565,7 +908,7 @@ void LanguageServer::onDidOpenTextDocument(const lsp::DidOpenTextDocumentParams&
     // however if a client doesn't yet support it, we push the diagnostics instead
     if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
     {
-        pushDiagnostics(workspace, params.textDocument.uri, params.textDocument.version);
+        pushDiagnostics(workspace, params.textDocument.uri, params.textDocument.version, /* allowDeferredTypeCheck: */ true);
     }
 }
 
@@ -584,44 +927,43 @@ void LanguageServer::onDidChangeTextDocument(const lsp::DidChangeTextDocumentPar
     if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
     {
         // Convert the diagnostics report into a series of diagnostics published for each relevant file
-        auto diagnostics = workspace->documentDiagnostics(lsp::DocumentDiagnosticParams{{params.textDocument.uri}});
+        auto diagnostics =
+            workspace->documentDiagnostics(lsp::DocumentDiagnosticParams{{params.textDocument.uri}}, /* allowDeferredTypeCheck: */ true);
         client->publishDiagnostics(lsp::PublishDiagnosticsParams{params.textDocument.uri, params.textDocument.version, diagnostics.items});
 
-        // Compute diagnostics for reverse dependencies
-        // TODO: should we put this inside documentDiagnostics so it works in the pull based model as well? (its a reverse BFS which is expensive)
-        // TODO: maybe this should only be done onSave
+        // Compute diagnostics for reverse dependencies. When dependents are rechecked on save, none will have been returned
+        pushDependentDiagnostics(workspace, params.textDocument.uri, markedDirty, diagnostics);
+    }
+    else
+    {
+        // In the pull based model, the client only requests diagnostics for the changed document.
+        // Queue up the dependents so that they are recomputed in the background, in between processing messages
         auto config = client->getConfiguration(workspace->rootUri);
         if (config.diagnostics.includeDependents || config.diagnostics.workspace)
-        {
-            std::unordered_map<std::string, lsp::SingleDocumentDiagnosticReport> reverseDependencyDiagnostics{};
-            for (auto& module : markedDirty)
-            {
-                auto filePath = workspace->fileResolver.resolveToRealPath(module);
-                if (filePath)
-                {
-                    auto uri = Uri::file(*filePath);
-                    if (uri != params.textDocument.uri && !contains(diagnostics.relatedDocuments, uri.toString()) &&
-                        !workspace->isIgnoredFile(*filePath, config))
-                    {
-                        auto dependencyDiags = workspace->documentDiagnostics(lsp::DocumentDiagnosticParams{{uri}});
-                        diagnostics.relatedDocuments.emplace(uri.toString(),
-                            lsp::SingleDocumentDiagnosticReport{dependencyDiags.kind, dependencyDiags.resultId, dependencyDiags.items});
-                        diagnostics.relatedDocuments.merge(dependencyDiags.relatedDocuments);
-                    }
-                }
-            }
-        }
+            workspace->queueDependentDiagnostics(workspace->fileResolver.getModuleName(params.textDocument.uri), markedDirty);
+    }
+}
 
-        if (!diagnostics.relatedDocuments.empty())
-        {
-            for (const auto& [uri, relatedDiagnostics] : diagnostics.relatedDocuments)
-            {
-                if (relatedDiagnostics.kind == lsp::DocumentDiagnosticReportKind::Full)
-                {
-                    client->publishDiagnostics(lsp::PublishDiagnosticsParams{Uri::parse(uri), std::nullopt, relatedDiagnostics.items});
-                }
-            }
-        }
+void LanguageServer::onDidSaveTextDocument(const lsp::DidSaveTextDocumentParams& params)
+{
+    // If recomputing the diagnostics of dependents was deferred until save, then recompute them now
+    std::vector<Luau::ModuleName> markedDirty{};
+    auto workspace = findWorkspace(params.textDocument.uri);
+    workspace->saveTextDocument(params.textDocument.uri, &markedDirty);
+
+    if (markedDirty.empty())
+        return;
+
+    if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
+    {
+        lsp::DocumentDiagnosticReport diagnostics{};
+        pushDependentDiagnostics(workspace, params.textDocument.uri, markedDirty, diagnostics);
+    }
+    else
+    {
+        auto config = client->getConfiguration(workspace->rootUri);
+        if (config.diagnostics.includeDependents || config.diagnostics.workspace)
+            workspace->queueDependentDiagnostics(workspace->fileResolver.getModuleName(params.textDocument.uri), markedDirty);
     }
 }
 
@@ -694,10 +1036,151 @@ void LanguageServer::onDidChangeWorkspaceFolders(const lsp::DidChangeWorkspaceFo
     client->requestConfiguration(configItems);
 }
 
+void LanguageServer::onDidRenameFiles(const lsp::RenameFilesParams& params)
+{
+    for (const auto& file : params.files)
+    {
+        // The file watcher only reports source files, so renamed folders are updated here
+        if (file.oldUri.scheme == "file" && file.newUri.scheme == "file")
+        {
+            auto newPath = file.newUri.fsPath();
+            findWorkspace(file.oldUri)->directoryInventory.deleted(file.oldUri.fsPath());
+            findWorkspace(file.newUri)->directoryInventory.created(newPath, std::filesystem::is_directory(newPath));
+        }
+
+        // Files moved between workspaces are handled as a deletion and a creation when reported by the file watcher
+        auto workspace = findWorkspace(file.oldUri);
+        if (findWorkspace(file.newUri) != workspace)
+            continue;
+
+        auto config = client->getConfiguration(workspace->rootUri);
+
+        std::vector<Luau::ModuleName> markedDirty{};
+        auto remapped = workspace->renameFile(file.oldUri, file.newUri, &markedDirty);
+        client->sendTrace(
+            "Remapped " + std::to_string(remapped) + " modules renamed from " + file.oldUri.toString() + " to " + file.newUri.toString());
+
+        // Update the require graph of the modules whose requires now resolve differently
+        if (config.index.enabled && workspace->isConfigured)
+            for (const auto& moduleName : markedDirty)
+                workspace->frontend.parse(moduleName);
+    }
+}
+
+void LanguageServer::onDidCreateFiles(const lsp::CreateFilesParams& params)
+{
+    // The file watcher only reports source files, so created folders are recorded here
+    for (const auto& file : params.files)
+    {
+        if (file.uri.scheme != "file")
+            continue;
+
+        auto path = file.uri.fsPath();
+        findWorkspace(file.uri)->directoryInventory.created(path, std::filesystem::is_directory(path));
+    }
+}
+
+void LanguageServer::onDidDeleteFiles(const lsp::DeleteFilesParams& params)
+{
+    // The file watcher only reports source files, so deleted folders are forgotten here
+    for (const auto& file : params.files)
+    {
+        if (file.uri.scheme == "file")
+            findWorkspace(file.uri)->directoryInventory.deleted(file.uri.fsPath());
+    }
+}
+
+static bool isSourceFile(const std::filesystem::path& path)
+{
+    return path.extension() == ".lua" || path.extension() == ".luau";
+}
+
+/// File watchers report a renamed or moved file as a deletion and a creation in the same batch.
+/// Returns the index of the creation paired with each deletion
+static std::unordered_map<size_t, size_t> findRenamedFiles(const std::vector<lsp::FileEvent>& changes)
+{
+    std::vector<size_t> deleted;
+    std::vector<size_t> created;
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        if (!isSourceFile(changes[i].uri.fsPath()))
+            continue;
+
+        if (changes[i].type == lsp::FileChangeType::Deleted)
+            deleted.push_back(i);
+        else if (changes[i].type == lsp::FileChangeType::Created)
+            created.push_back(i);
+    }
+
+    // A file deleted and created at the same path (e.g. when an editor saves by replacing the file) was not renamed
+    auto isReplaced = [&](size_t index)
+    {
+        const auto& candidates = changes[index].type == lsp::FileChangeType::Deleted ? created : deleted;
+        return std::any_of(candidates.begin(), candidates.end(),
+            [&](size_t other)
+            {
+                return changes[other].uri == changes[index].uri;
+            });
+    };
+    deleted.erase(std::remove_if(deleted.begin(), deleted.end(), isReplaced), deleted.end());
+    created.erase(std::remove_if(created.begin(), created.end(), isReplaced), created.end());
+
+    std::unordered_map<size_t, size_t> renames;
+    std::vector<bool> paired(changes.size(), false);
+
+    // Moved files keep their file name
+    for (auto from : deleted)
+    {
+        for (auto to : created)
+        {
+            if (!paired[to] && changes[from].uri.fsPath().filename() == changes[to].uri.fsPath().filename())
+            {
+                renames.emplace(from, to);
+                paired[from] = paired[to] = true;
+                break;
+            }
+        }
+    }
+
+    // Otherwise, a single deletion and creation within the same folder is a file being renamed
+    std::vector<size_t> unpairedDeleted;
+    std::vector<size_t> unpairedCreated;
+    std::copy_if(deleted.begin(), deleted.end(), std::back_inserter(unpairedDeleted),
+        [&](size_t index)
+        {
+            return !paired[index];
+        });
+    std::copy_if(created.begin(), created.end(), std::back_inserter(unpairedCreated),
+        [&](size_t index)
+        {
+            return !paired[index];
+        });
+    if (unpairedDeleted.size() == 1 && unpairedCreated.size() == 1 &&
+        changes[unpairedDeleted[0]].uri.fsPath().parent_path() == changes[unpairedCreated[0]].uri.fsPath().parent_path())
+        renames.emplace(unpairedDeleted[0], unpairedCreated[0]);
+
+    return renames;
+}
+
 void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesParams& params)
 {
-    for (const auto& change : params.changes)
+    auto renames = findRenamedFiles(params.changes);
+    std::unordered_set<size_t> renameTargets;
+    for (auto it = renames.begin(); it != renames.end();)
     {
+        // Files moved between workspaces are handled as a deletion and a creation
+        if (findWorkspace(params.changes[it->first].uri) != findWorkspace(params.changes[it->second].uri))
+        {
+            it = renames.erase(it);
+            continue;
+        }
+        renameTargets.insert(it->second);
+        ++it;
+    }
+
+    for (size_t i = 0; i < params.changes.size(); i++)
+    {
+        const auto& change = params.changes[i];
         auto workspace = findWorkspace(change.uri);
         auto config = client->getConfiguration(workspace->rootUri);
         auto filePath = change.uri.fsPath();
@@ -706,7 +1189,7 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
         if (filePath.filename() == "sourcemap.json")
         {
             client->sendLogMessage(lsp::MessageType::Info, "Registering sourcemap changed for workspace " + workspace->name);
-            workspace->updateSourceMap();
+            workspace->updateSourceMap(InvalidationCause::SourcemapChanged);
 
             // Recompute diagnostics
             this->recomputeDiagnostics(workspace, config);
@@ -720,8 +1203,14 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
             // Recompute diagnostics
             this->recomputeDiagnostics(workspace, config);
         }
-        else if (filePath.extension() == ".lua" || filePath.extension() == ".luau")
+        else if (isSourceFile(filePath))
         {
+            // Keep the directory listings used to complete require paths current
+            if (change.type == lsp::FileChangeType::Created)
+                workspace->directoryInventory.created(filePath, /* isDirectory: */ false);
+            else if (change.type == lsp::FileChangeType::Deleted)
+                workspace->directoryInventory.deleted(filePath);
+
             // Notify if it was a definitions file
             if (workspace->isDefinitionFile(filePath, config))
             {
@@ -730,6 +1219,27 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
                 continue;
             }
 
+            // The creation of a renamed file is handled alongside its deletion
+            if (renameTargets.find(i) != renameTargets.end())
+                continue;
+
+            if (auto renamed = renames.find(i); renamed != renames.end())
+            {
+                const auto& newUri = params.changes[renamed->second].uri;
+
+                std::vector<Luau::ModuleName> markedDirty{};
+                workspace->renameFile(change.uri, newUri, &markedDirty);
+
+                // Update the require graph of the modules whose requires now resolve differently
+                if (config.index.enabled && workspace->isConfigured)
+                {
+                    workspace->frontend.parse(workspace->fileResolver.getModuleName(newUri));
+                    for (const auto& moduleName : markedDirty)
+                        workspace->frontend.parse(moduleName);
+                }
+                continue;
+            }
+
             // Index the workspace on changes
             // We only update the require graph. We do not perform type checking
             if (config.index.enabled && workspace->isConfigured)
@@ -737,7 +1247,7 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
                 auto moduleName = workspace->fileResolver.getModuleName(change.uri);
 
                 std::vector<Luau::ModuleName> markedDirty{};
-                workspace->frontend.markDirty(moduleName, &markedDirty);
+                workspace->markDirty(moduleName, InvalidationCause::FileChanged, &markedDirty);
 
                 if (change.type == lsp::FileChangeType::Created)
                     workspace->frontend.parse(moduleName);
@@ -754,8 +1264,123 @@ void LanguageServer::onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesPar
     }
 }
 
+/// Starts sampling the server's call stacks, writing them out as folded stacks once the duration has elapsed.
+/// Samples are only taken whilst the server is busy, and the profile is written once the next message has been handled
+Response LanguageServer::profile(const ProfileParams& params)
+{
+    if (!Profiler::isSupported())
+        throw JsonRpcException(lsp::ErrorCode::RequestFailed, "profiling is not supported on this platform");
+    if (profiler.isRunning())
+        throw JsonRpcException(lsp::ErrorCode::RequestFailed, "a profile is already in progress");
+
+    try
+    {
+        profiler.start(params);
+    }
+    catch (const std::exception& e)
+    {
+        throw JsonRpcException(lsp::ErrorCode::RequestFailed, e.what());
+    }
+
+    client->sendLogMessage(lsp::MessageType::Info, "Started profiling for " + std::to_string(params.duration) + "s, writing to " + params.path);
+    return nullptr;
+}
+
+/// Explains why the document's module was recently marked for rechecking, alongside the invalidations recorded across its workspace.
+/// Used to find invalidation paths which recheck more than they need to
+Response LanguageServer::invalidations(const lsp::TextDocumentIdentifier& params)
+{
+    auto workspace = findWorkspace(params.uri);
+    auto moduleName = workspace->fileResolver.getModuleName(params.uri);
+
+    return json{
+        {"module", moduleName},
+        {"invalidations", workspace->invalidationLog.forModule(moduleName)},
+        {"recent", workspace->invalidationLog.recent()},
+    };
+}
+
+void LanguageServer::pollProfiler(bool force)
+{
+    try
+    {
+        if (auto summary = profiler.poll(force))
+            client->sendWindowMessage(lsp::MessageType::Info, *summary);
+    }
+    catch (const std::exception& e)
+    {
+        client->sendWindowMessage(lsp::MessageType::Error, std::string("Failed to write profile: ") + e.what());
+    }
+}
+
+/// Releases the caches held for closed files, cheapest to rebuild first, if the memory in use is approaching the budget
+void LanguageServer::enforceMemoryBudget()
+{
+    static constexpr auto CHECK_INTERVAL = std::chrono::seconds(1);
+
+    auto now = tracing::Clock::now();
+    if (now - lastMemoryCheck < CHECK_INTERVAL)
+        return;
+    lastMemoryCheck = now;
+
+    memoryGovernor.setConfiguredBudget(client->globalConfig.memory.limit * 1024 * 1024);
+    auto budget = memoryGovernor.getBudget();
+    if (!budget)
+        return;
+
+    // Estimating the size of the caches visits every module, which we can skip whilst the process is well within the budget
+    auto residentMemory = MemoryGovernor::readResidentMemory();
+    if (residentMemory && static_cast<double>(*residentMemory) < static_cast<double>(*budget) * MemoryGovernor::PRESSURE_THRESHOLD)
+    {
+        memoryGovernor.bytesToRelease(*residentMemory, /* cachedBytes: */ 0);
+        return;
+    }
+
+    std::vector<WorkspaceFolderPtr> workspaces = workspaceFolders;
+    workspaces.push_back(nullWorkspace);
+
+    CacheUsage usage;
+    for (const auto& workspace : workspaces)
+        usage += workspace->estimateCacheUsage();
+
+    auto usedBytes = residentMemory.value_or(usage.total());
+    auto bytesToRelease = memoryGovernor.bytesToRelease(usedBytes, usage.total());
+    if (bytesToRelease == 0)
+        return;
+
+    recentResponses.clear();
+
+    // Pending requests may hold onto types and syntax trees which are about to be released
+    cancelPendingRequests(lsp::ErrorCode::ServerCancelled, "request cancelled to release memory");
+
+    // A syntax tree can only be released once its type graphs are, so syntax trees are revisited after releasing type graphs
+    static constexpr CacheKind RELEASE_ORDER[] = {CacheKind::Results, CacheKind::SyntaxTrees, CacheKind::TypeGraphs, CacheKind::SyntaxTrees};
+
+    size_t released = 0;
+    for (auto kind : RELEASE_ORDER)
+    {
+        if (released >= bytesToRelease)
+            break;
+
+        for (const auto& workspace : workspaces)
+            released += workspace->releaseCache(kind);
+    }
+    memoryGovernor.recordRelease(usage.total() - std::min(released, usage.total()));
+
+    constexpr size_t MEGABYTE = 1024 * 1024;
+    client->sendLogMessage(lsp::MessageType::Info, "Memory usage of " + std::to_string(usedBytes / MEGABYTE) + "MB is approaching the budget of " +
+                                                       std::to_string(*budget / MEGABYTE) + "MB, released approximately " +
+                                                       std::to_string(released / MEGABYTE) + "MB of caches held for closed files");
+}
+
 Response LanguageServer::onShutdown([[maybe_unused]] const id_type& id)
 {
+    for (auto& workspace : workspaceFolders)
+        workspace->saveCaches();
+
+    pollProfiler(/* force: */ true);
+    cancelPendingRequests(lsp::ErrorCode::InvalidRequest, "server is shutting down");
+
     shutdownRequested = true;
     return nullptr;
 }
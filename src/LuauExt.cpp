@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Luau/BuiltinDefinitions.h"
 #include "Luau/ToString.h"
 #include "Luau/Transpiler.h"
@@ -69,6 +71,19 @@ Luau::TypeId getSourcemapType(const Luau::GlobalTypes& globals, Luau::TypeArena&
     if (node->tys.find(&globals) != node->tys.end())
         return node->tys.at(&globals);
 
+    // Leaf nodes (with no children) of the same class under the same parent produce an identical type,
+    // so reuse a canonical type for them rather than creating a new one for every leaf instance
+    auto leafParent = node->children.empty() ? node->parent.lock() : nullptr;
+    if (leafParent)
+    {
+        auto& leafTys = leafParent->leafTys[&globals];
+        if (auto it = leafTys.find(node->className); it != leafTys.end())
+        {
+            node->tys.insert_or_assign(&globals, it->second);
+            return it->second;
+        }
+    }
+
     Luau::LazyType ltv(
         [&globals, &arena, node](Luau::LazyType& ltv) -> void
         {
@@ -171,6 +186,8 @@ Luau::TypeId getSourcemapType(const Luau::GlobalTypes& globals, Luau::TypeArena&
         });
     auto ty = arena.addType(std::move(ltv));
     node->tys.insert_or_assign(&globals, ty);
+    if (leafParent)
+        leafParent->leafTys[&globals].insert_or_assign(node->className, ty);
 
     return ty;
 }
@@ -300,11 +317,11 @@ static std::optional<Luau::WithPredicate<Luau::TypePackId>> magicFunctionGetProp
     return std::nullopt;
 }
 
-void addChildrenToCTV(const Luau::GlobalTypes& globals, Luau::TypeArena& arena, const Luau::TypeId& ty, const SourceNodePtr& node)
+// Clears out all the old registered children
+static void clearChildrenFromCTV(const Luau::TypeId& ty)
 {
     if (auto* ctv = Luau::getMutable<Luau::ClassType>(ty))
     {
-        // Clear out all the old registered children
         for (auto it = ctv->props.begin(); it != ctv->props.end();)
         {
             if (hasTag(it->second, "@sourcemap-generated"))
@@ -312,8 +329,15 @@ void addChildrenToCTV(const Luau::GlobalTypes& globals, Luau::TypeArena& arena,
             else
                 ++it;
         }
+    }
+}
 
+void addChildrenToCTV(const Luau::GlobalTypes& globals, Luau::TypeArena& arena, const Luau::TypeId& ty, const SourceNodePtr& node)
+{
+    clearChildrenFromCTV(ty);
 
+    if (auto* ctv = Luau::getMutable<Luau::ClassType>(ty))
+    {
         // Extend the props to include the children
         for (const auto& child : node->children)
         {
@@ -329,12 +353,86 @@ void addChildrenToCTV(const Luau::GlobalTypes& globals, Luau::TypeArena& arena,
     }
 }
 
+// Defers attaching the children of `node` to the globally defined class `className` until the class is referenced
+static void deferChildrenToCTV(
+    DeferredInstanceChildren& deferredChildren, const Luau::GlobalTypes& globals, const std::string& className, const SourceNodePtr& node)
+{
+    if (auto classType = globals.globalScope->lookupType(className))
+        deferredChildren.pending[&globals].insert_or_assign(className, DeferredInstanceChildren::Entry{classType->type, node});
+}
+
+// Attaches any deferred sourcemap children for the class `className`, if they have not yet been attached
+static void materializeDeferredChildren(
+    DeferredInstanceChildren& deferredChildren, const Luau::GlobalTypes& globals, Luau::TypeArena& arena, const std::string& className)
+{
+    auto pendingForGlobals = deferredChildren.pending.find(&globals);
+    if (pendingForGlobals == deferredChildren.pending.end())
+        return;
+
+    auto entry = pendingForGlobals->second.find(className);
+    if (entry == pendingForGlobals->second.end())
+        return;
+
+    addChildrenToCTV(globals, arena, entry->second.ty, entry->second.node);
+    deferredChildren.materialized[&globals].push_back(entry->second.ty);
+    pendingForGlobals->second.erase(entry);
+}
+
+// Finds all the names and string constants used in a module which refer to classes with deferred children.
+// Class types are referenced through type annotations (`ReplicatedStorage`), service lookups (`game:GetService("ReplicatedStorage")`)
+// or property accesses (`player.PlayerGui`), so this is a conservative approximation of the classes the module may use
+struct DeferredChildrenReferenceVisitor : public Luau::AstVisitor
+{
+    const std::unordered_map<std::string, DeferredInstanceChildren::Entry>& pending;
+    std::vector<std::string> referenced{};
+
+    explicit DeferredChildrenReferenceVisitor(const std::unordered_map<std::string, DeferredInstanceChildren::Entry>& pending)
+        : pending(pending)
+    {
+    }
+
+    void addReference(const std::string& name)
+    {
+        if (contains(pending, name) && !contains(referenced, name))
+            referenced.push_back(name);
+    }
+
+    bool visit(Luau::AstExprConstantString* node) override
+    {
+        addReference(std::string(node->value.data, node->value.size));
+        return true;
+    }
+
+    bool visit(Luau::AstExprIndexName* node) override
+    {
+        addReference(node->index.value);
+        return true;
+    }
+
+    bool visit(Luau::AstType* node) override
+    {
+        return true;
+    }
+
+    bool visit(Luau::AstTypeReference* node) override
+    {
+        addReference(node->name.value);
+        return true;
+    }
+};
+
 // TODO: expressiveTypes is used because of a Luau issue where we can't cast a most specific Instance type (which we create here)
 // to another type. For the time being, we therefore make all our DataModel instance types marked as "any".
 // Remove this once Luau has improved
 void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& globals, Luau::TypeArena& arena,
-    const WorkspaceFileResolver& fileResolver, bool expressiveTypes)
+    const WorkspaceFileResolver& fileResolver, DeferredInstanceChildren& deferredChildren, bool expressiveTypes)
 {
+    // Reset any children attached from a previous sourcemap. Only the classes which were actually referenced need clearing
+    for (const auto& ty : deferredChildren.materialized[&globals])
+        clearChildrenFromCTV(ty);
+    deferredChildren.materialized.erase(&globals);
+    deferredChildren.pending.erase(&globals);
+
     if (!fileResolver.rootSourceNode)
         return;
 
@@ -348,12 +446,12 @@ void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& gl
         if (auto dataModelType = globals.globalScope->lookupType("DataModel"))
             addChildrenToCTV(globals, arena, dataModelType->type, fileResolver.rootSourceNode);
 
-        // Mutate globally-registered Services to include children information (so it's available through :GetService)
+        // Globally-registered Services should include children information (so it's available through :GetService)
+        // These are only attached when the service is first referenced, as most services are never used by a given workspace
         for (const auto& service : fileResolver.rootSourceNode->children)
         {
             auto serviceName = service->className; // We know it must be a service of the same class name
-            if (auto serviceType = globals.globalScope->lookupType(serviceName))
-                addChildrenToCTV(globals, arena, serviceType->type, service);
+            deferChildrenToCTV(deferredChildren, globals, serviceName, service);
         }
 
         // Add containers to player and copy over instances
@@ -373,7 +471,7 @@ void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& gl
                 if (auto playerGuiType = globals.globalScope->lookupType("PlayerGui"))
                 {
                     if (auto starterGui = fileResolver.rootSourceNode->findChild("StarterGui"))
-                        addChildrenToCTV(globals, arena, playerGuiType->type, *starterGui);
+                        deferChildrenToCTV(deferredChildren, globals, "PlayerGui", *starterGui);
                     ctv->props["PlayerGui"] = Luau::makeProperty(playerGuiType->type);
                 }
 
@@ -381,7 +479,7 @@ void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& gl
                 if (auto starterGearType = globals.globalScope->lookupType("StarterGear"))
                 {
                     if (auto starterPack = fileResolver.rootSourceNode->findChild("StarterPack"))
-                        addChildrenToCTV(globals, arena, starterGearType->type, *starterPack);
+                        deferChildrenToCTV(deferredChildren, globals, "StarterGear", *starterPack);
 
                     ctv->props["StarterGear"] = Luau::makeProperty(starterGearType->type);
                 }
@@ -393,7 +491,7 @@ void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& gl
                     {
                         if (auto starterPlayerScripts = starterPlayer.value()->findChild("StarterPlayerScripts"))
                         {
-                            addChildrenToCTV(globals, arena, playerScriptsType->type, *starterPlayerScripts);
+                            deferChildrenToCTV(deferredChildren, globals, "PlayerScripts", *starterPlayerScripts);
                         }
                     }
                     ctv->props["PlayerScripts"] = Luau::makeProperty(playerScriptsType->type);
@@ -403,11 +501,23 @@ void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& gl
     }
 
     // Prepare module scope so that we can dynamically reassign the type of "script" to retrieve instance info
-    frontend.prepareModuleScope = [&frontend, &fileResolver, &arena, expressiveTypes](
+    frontend.prepareModuleScope = [&frontend, &fileResolver, &arena, &deferredChildren, expressiveTypes](
                                       const Luau::ModuleName& name, const Luau::ScopePtr& scope, bool forAutocomplete)
     {
         Luau::GlobalTypes& globals = forAutocomplete ? frontend.globalsForAutocomplete : frontend.globals;
 
+        // Attach the children of any deferred classes which this module references, before it is type checked
+        if (auto pending = deferredChildren.pending.find(&globals); pending != deferredChildren.pending.end() && !pending->second.empty())
+        {
+            if (auto sourceModule = frontend.getSourceModule(name); sourceModule && sourceModule->root)
+            {
+                DeferredChildrenReferenceVisitor visitor{pending->second};
+                sourceModule->root->visit(&visitor);
+                for (const auto& className : visitor.referenced)
+                    materializeDeferredChildren(deferredChildren, globals, arena, className);
+            }
+        }
+
         // TODO: we hope to remove these in future!
         if (!expressiveTypes && !forAutocomplete)
         {
@@ -1256,6 +1366,62 @@ std::optional<Luau::Location> getLocation(Luau::TypeId type)
     return std::nullopt;
 }
 
+ScopeIndex::ScopeIndex(const Luau::Module& module)
+{
+    if (module.scopes.empty())
+        return;
+
+    moduleScope = module.scopes.front().second;
+
+    entries.reserve(module.scopes.size());
+    for (const auto& [location, scope] : module.scopes)
+        entries.emplace_back(Entry{location, scope});
+
+    // `Luau::findScopeAtPosition` prefers later scopes when locations are equal, so a stable sort keeps them after earlier ones
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const Entry& a, const Entry& b)
+        {
+            if (a.location.begin != b.location.begin)
+                return a.location.begin < b.location.begin;
+            return b.location.end < a.location.end;
+        });
+
+    // Scopes are nested, so the enclosing scopes of each entry are the entries still on the stack which enclose it
+    std::vector<size_t> stack;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        while (!stack.empty() && !entries[stack.back()].location.encloses(entries[i].location))
+            stack.pop_back();
+
+        if (!stack.empty())
+            entries[i].parent = stack.back();
+        stack.push_back(i);
+    }
+}
+
+Luau::ScopePtr ScopeIndex::findScopeAtPosition(Luau::Position pos) const
+{
+    // Find the last scope starting at or before the position. The innermost scope containing the position is either this scope
+    // or one which encloses it, as any scope starting between the two would be nested within the innermost scope
+    auto it = std::upper_bound(entries.begin(), entries.end(), pos,
+        [](const Luau::Position& position, const Entry& entry)
+        {
+            return position < entry.location.begin;
+        });
+    if (it == entries.begin())
+        return moduleScope;
+
+    size_t index = std::distance(entries.begin(), it) - 1;
+    while (index != NO_PARENT)
+    {
+        if (entries[index].location.contains(pos))
+            return entries[index].scope;
+        index = entries[index].parent;
+    }
+
+    return moduleScope;
+}
+
 bool isGetService(const Luau::AstExpr* expr)
 {
     if (auto call = expr->as<Luau::AstExprCall>())
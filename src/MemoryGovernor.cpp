@@ -0,0 +1,103 @@
+#include "LSP/MemoryGovernor.hpp"
+#include "LSP/Utils.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+// cgroup v1 reports an unlimited memory limit as a very large number (rounded down to the page size) rather than "max"
+static constexpr size_t UNLIMITED_CGROUP_V1_LIMIT = size_t(1) << 60;
+
+void MemoryGovernor::setConfiguredBudget(size_t bytes)
+{
+    configuredBudget = bytes > 0 ? std::optional<size_t>(bytes) : std::nullopt;
+}
+
+std::optional<size_t> MemoryGovernor::getBudget()
+{
+    if (configuredBudget)
+        return configuredBudget;
+
+    // The limit of the container does not change whilst we are running
+    if (!hasDetectedBudget)
+    {
+        detectedBudget = readCgroupLimit();
+        hasDetectedBudget = true;
+    }
+    return detectedBudget;
+}
+
+size_t MemoryGovernor::bytesToRelease(size_t usedBytes, size_t cachedBytes)
+{
+    auto budget = getBudget();
+    if (!budget || static_cast<double>(usedBytes) < static_cast<double>(*budget) * PRESSURE_THRESHOLD)
+    {
+        cachedBytesAfterRelease = std::nullopt;
+        return 0;
+    }
+
+    // If the caches have not grown since they were last released, the memory is held elsewhere and releasing
+    // what remains of the caches is unlikely to help
+    if (cachedBytesAfterRelease && cachedBytes <= *cachedBytesAfterRelease)
+        return 0;
+
+    auto target = static_cast<size_t>(static_cast<double>(*budget) * RELEASE_TARGET);
+    return std::min(usedBytes - std::min(usedBytes, target), cachedBytes);
+}
+
+void MemoryGovernor::recordRelease(size_t remainingCachedBytes)
+{
+    cachedBytesAfterRelease = remainingCachedBytes;
+}
+
+std::optional<size_t> MemoryGovernor::readCgroupLimit(const std::filesystem::path& cgroupRoot)
+{
+    if (auto contents = readFile(cgroupRoot / "memory.max"))
+    {
+        size_t limit = 0;
+        std::istringstream stream(*contents);
+        // A limit of "max" means that the memory is unbounded
+        if (stream >> limit && limit > 0)
+            return limit;
+        return std::nullopt;
+    }
+
+    if (auto contents = readFile(cgroupRoot / "memory" / "memory.limit_in_bytes"))
+    {
+        size_t limit = 0;
+        std::istringstream stream(*contents);
+        if (stream >> limit && limit > 0 && limit < UNLIMITED_CGROUP_V1_LIMIT)
+            return limit;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<size_t> MemoryGovernor::readResidentMemory()
+{
+#if defined(__linux__)
+    // The second field of statm is the resident set size, in pages
+    if (auto contents = readFile("/proc/self/statm"))
+    {
+        size_t totalPages = 0;
+        size_t residentPages = 0;
+        std::istringstream stream(*contents);
+        if (stream >> totalPages >> residentPages)
+            return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    return std::nullopt;
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+        return static_cast<size_t>(info.resident_size);
+    return std::nullopt;
+#else
+    return std::nullopt;
+#endif
+}
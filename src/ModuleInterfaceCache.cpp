@@ -0,0 +1,184 @@
+#include "LSP/ModuleInterfaceCache.hpp"
+#include "LSP/Utils.hpp"
+
+#include "Luau/StringUtils.h"
+#include "Luau/ToString.h"
+#include "Luau/TypePack.h"
+
+#include <algorithm>
+#include <fstream>
+
+/// Bumped whenever the format of the cache (or the serialization of interfaces) changes, to invalidate old caches
+static constexpr int CACHE_FORMAT_VERSION = 3;
+
+void ModuleInterfaceCache::load(const std::filesystem::path& cachePath)
+{
+    path = cachePath;
+    environmentHash.clear();
+    entries.clear();
+
+    auto contents = readFile(cachePath);
+    if (!contents)
+        return;
+
+    try
+    {
+        auto data = json::parse(*contents);
+        if (data.value("version", 0) != CACHE_FORMAT_VERSION)
+            return;
+
+        environmentHash = data.at("environmentHash").get<std::string>();
+        entries = data.at("modules").get<std::unordered_map<std::string, CachedModuleInterface>>();
+    }
+    catch (const std::exception&)
+    {
+        // The cache is corrupt, so we start again from scratch
+        environmentHash.clear();
+        entries.clear();
+    }
+}
+
+const CachedModuleInterface* ModuleInterfaceCache::find(const std::string& moduleName, const std::string& currentEnvironmentHash) const
+{
+    if (environmentHash != currentEnvironmentHash)
+        return nullptr;
+
+    auto it = entries.find(moduleName);
+    if (it == entries.end())
+        return nullptr;
+    return &it->second;
+}
+
+void ModuleInterfaceCache::store(const std::string& moduleName, CachedModuleInterface entry, const std::string& currentEnvironmentHash)
+{
+    // Entries from a previous session computed in a different environment may no longer be valid
+    if (environmentHash != currentEnvironmentHash)
+    {
+        environmentHash = currentEnvironmentHash;
+        entries.clear();
+    }
+
+    entries.insert_or_assign(moduleName, std::move(entry));
+}
+
+bool ModuleInterfaceCache::save()
+{
+    if (!path)
+        return false;
+
+    json data;
+    data["version"] = CACHE_FORMAT_VERSION;
+    data["environmentHash"] = environmentHash;
+    data["modules"] = entries;
+
+    std::error_code ec;
+    std::filesystem::create_directories(path->parent_path(), ec);
+
+    std::ofstream file(*path, std::ios::out | std::ios::trunc);
+    if (!file)
+        return false;
+    file << data.dump();
+    return file.good();
+}
+
+std::vector<std::string> serializeModuleInterface(const Luau::Module& module)
+{
+    // The serialized types must never be truncated, otherwise changes to the interface may go unnoticed
+    Luau::ToStringOptions opts;
+    opts.exhaustive = true;
+    opts.maxTableLength = 0;
+    opts.maxTypeLength = 0;
+
+    std::vector<std::string> exports;
+    exports.reserve(module.exportedTypeBindings.size() + 1);
+
+    for (const auto& [name, typeFun] : module.exportedTypeBindings)
+    {
+        std::string declaration = "export type " + name;
+        if (!typeFun.typeParams.empty() || !typeFun.typePackParams.empty())
+        {
+            std::vector<std::string> params;
+            for (const auto& param : typeFun.typeParams)
+                params.emplace_back(Luau::toString(param.ty, opts));
+            for (const auto& param : typeFun.typePackParams)
+                params.emplace_back(Luau::toString(param.tp, opts));
+            declaration += "<" + Luau::join(params, ", ") + ">";
+        }
+        declaration += " = " + Luau::toString(typeFun.type, opts);
+        exports.emplace_back(std::move(declaration));
+    }
+
+    // Type bindings are unordered, so sort them to produce a stable interface
+    std::sort(exports.begin(), exports.end());
+
+    if (module.returnType)
+        exports.emplace_back("return " + Luau::toString(module.returnType, opts));
+
+    return exports;
+}
+
+std::string hashModuleInterface(const std::vector<std::string>& exports)
+{
+    std::string contents;
+    for (const auto& declaration : exports)
+        contents += declaration + '\n';
+    return hashString(contents);
+}
+
+std::optional<std::string> createInterfaceStub(const Luau::Module& module)
+{
+    // Sealed tables are written as plain table types, as that is what an annotation declares
+    Luau::ToStringOptions opts;
+    opts.exhaustive = true;
+    opts.hideTableKind = true;
+    opts.maxTableLength = 0;
+    opts.maxTypeLength = 0;
+
+    bool representable = true;
+    auto write = [&](auto type)
+    {
+        auto result = Luau::toStringDetailed(type, opts);
+        if (result.invalid || result.error || result.cycle || result.truncated)
+            representable = false;
+        return result.name;
+    };
+
+    std::vector<std::string> declarations;
+    declarations.reserve(module.exportedTypeBindings.size());
+
+    for (const auto& [name, typeFun] : module.exportedTypeBindings)
+    {
+        std::string declaration = "export type " + name;
+        if (!typeFun.typeParams.empty() || !typeFun.typePackParams.empty())
+        {
+            std::vector<std::string> params;
+            for (const auto& param : typeFun.typeParams)
+                params.emplace_back(write(param.ty) + (param.defaultValue ? " = " + write(*param.defaultValue) : ""));
+            for (const auto& param : typeFun.typePackParams)
+                params.emplace_back(write(param.tp) + (param.defaultValue ? " = " + write(*param.defaultValue) : ""));
+            declaration += "<" + Luau::join(params, ", ") + ">";
+        }
+        declaration += " = " + write(typeFun.type);
+        declarations.emplace_back(std::move(declaration));
+    }
+
+    std::sort(declarations.begin(), declarations.end());
+
+    if (module.returnType)
+    {
+        // Each returned value is a cast of nil, so the stub does not depend on anything other than its own declarations
+        auto [returnTypes, tail] = Luau::flatten(module.returnType);
+        if (tail)
+            return std::nullopt;
+
+        std::vector<std::string> values;
+        for (auto returnType : returnTypes)
+            values.emplace_back("(nil :: any) :: " + write(returnType));
+        declarations.emplace_back("return " + Luau::join(values, ", "));
+    }
+
+    if (!representable)
+        return std::nullopt;
+
+    return "--!strict\n" + Luau::join(declarations, "\n") + '\n';
+}
@@ -0,0 +1,296 @@
+#include "LSP/Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// Stacks are captured by walking the frame pointer chain from the interrupted registers, so we need to know where to find them
+#if (defined(__linux__) || defined(__APPLE__)) && (defined(__x86_64__) || defined(__aarch64__))
+#define LSP_PROFILER_SUPPORTED 1
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+
+#ifdef LSP_PROFILER_SUPPORTED
+namespace
+{
+constexpr int MAX_STACK_DEPTH = 64;
+constexpr size_t MAX_SAMPLES = 200000;
+
+struct Sample
+{
+    int depth = 0;
+    void* frames[MAX_STACK_DEPTH];
+};
+
+// The signal handler may only touch state which is allocated before sampling starts, and lock-free atomics
+std::vector<Sample> samples;
+std::atomic<size_t> nextSample{0};
+std::atomic<long long> deadlineNanoseconds{0};
+struct sigaction previousAction;
+// The bounds of the server thread's stack. Every frame pointer we follow must lie within them, so that a corrupt chain
+// (e.g. through code compiled without frame pointers) ends the walk rather than reading unmapped memory
+uintptr_t stackLow = 0;
+uintptr_t stackHigh = 0;
+
+bool findStackBounds()
+{
+#if defined(__APPLE__)
+    stackHigh = reinterpret_cast<uintptr_t>(pthread_get_stackaddr_np(pthread_self()));
+    stackLow = stackHigh - pthread_get_stacksize_np(pthread_self());
+    return true;
+#else
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0)
+        return false;
+
+    void* address = nullptr;
+    size_t size = 0;
+    bool found = pthread_attr_getstack(&attributes, &address, &size) == 0;
+    pthread_attr_destroy(&attributes);
+
+    stackLow = reinterpret_cast<uintptr_t>(address);
+    stackHigh = stackLow + size;
+    return found;
+#endif
+}
+
+void readRegisters(const void* context, uintptr_t& pc, uintptr_t& fp)
+{
+    const auto* uc = static_cast<const ucontext_t*>(context);
+#if defined(__APPLE__) && defined(__x86_64__)
+    pc = uc->uc_mcontext->__ss.__rip;
+    fp = uc->uc_mcontext->__ss.__rbp;
+#elif defined(__APPLE__)
+    pc = reinterpret_cast<uintptr_t>(__darwin_arm_thread_state64_get_pc(uc->uc_mcontext->__ss));
+    fp = reinterpret_cast<uintptr_t>(__darwin_arm_thread_state64_get_fp(uc->uc_mcontext->__ss));
+#elif defined(__x86_64__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+#else
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.pc);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.regs[29]);
+#endif
+}
+
+// Walks the frame pointer chain of the interrupted code. Each frame record holds the caller's frame pointer followed by the return address.
+// This only reads memory within the stack, and does not allocate or take locks, unlike `backtrace`, so it is safe inside a signal handler
+int captureStack(const void* context, void** frames)
+{
+    uintptr_t pc = 0;
+    uintptr_t fp = 0;
+    readRegisters(context, pc, fp);
+
+    int depth = 0;
+    frames[depth++] = reinterpret_cast<void*>(pc);
+    while (depth < MAX_STACK_DEPTH)
+    {
+        if (fp % alignof(uintptr_t) != 0 || fp < stackLow || fp + 2 * sizeof(uintptr_t) > stackHigh)
+            break;
+
+        const auto* record = reinterpret_cast<const uintptr_t*>(fp);
+        uintptr_t next = record[0];
+        uintptr_t returnAddress = record[1];
+        if (returnAddress == 0)
+            break;
+        frames[depth++] = reinterpret_cast<void*>(returnAddress);
+
+        // The stack grows downwards, so the caller's frame is always at a higher address
+        if (next <= fp)
+            break;
+        fp = next;
+    }
+
+    return depth;
+}
+
+long long monotonicNanoseconds()
+{
+    timespec time{};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<long long>(time.tv_sec) * 1000000000LL + time.tv_nsec;
+}
+
+void setTimer(size_t frequency)
+{
+    itimerval timer{};
+    if (frequency > 0)
+    {
+        timer.it_interval.tv_sec = 0;
+        timer.it_interval.tv_usec = static_cast<suseconds_t>(std::max<size_t>(1000000 / frequency, 1));
+        timer.it_value = timer.it_interval;
+    }
+    setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+void onProfilingSignal(int, siginfo_t*, void* context)
+{
+    int savedErrno = errno;
+
+    if (monotonicNanoseconds() >= deadlineNanoseconds.load(std::memory_order_relaxed))
+    {
+        // Stop sampling once the duration has elapsed, even if the profile is not written until later
+        setTimer(0);
+    }
+    else if (size_t index = nextSample.fetch_add(1, std::memory_order_relaxed); index < samples.size())
+    {
+        auto& sample = samples[index];
+        sample.depth = captureStack(context, sample.frames);
+    }
+
+    errno = savedErrno;
+}
+
+std::string symbolize(void* address)
+{
+    Dl_info info{};
+    if (dladdr(address, &info) && info.dli_sname)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+
+        // Semicolons separate frames in the folded format
+        std::replace(name.begin(), name.end(), ';', ':');
+        return name;
+    }
+
+    // Fall back to the offset within the binary, which can be symbolized with `addr2line`
+    std::stringstream result;
+    if (info.dli_fname && info.dli_fbase)
+        result << std::filesystem::path(info.dli_fname).filename().string() << "+0x" << std::hex
+               << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+    else
+        result << address;
+    return result.str();
+}
+} // namespace
+#endif
+
+bool Profiler::isSupported()
+{
+#ifdef LSP_PROFILER_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::start(const ProfileParams& params)
+{
+#ifdef LSP_PROFILER_SUPPORTED
+    if (isRunning())
+        throw std::runtime_error("a profile is already in progress");
+    if (params.path.empty())
+        throw std::runtime_error("no output path provided for profile");
+    if (params.duration <= 0 || params.frequency == 0)
+        throw std::runtime_error("profile duration and frequency must be positive");
+
+    // Leave some headroom over the expected number of samples
+    auto expectedSamples = params.duration * static_cast<double>(params.frequency) * 1.1 + 16;
+    samples.assign(std::min(static_cast<size_t>(expectedSamples), MAX_SAMPLES), Sample{});
+    nextSample = 0;
+
+    // Finding the stack bounds may allocate, so it must happen before the signal handler is installed
+    if (!findStackBounds())
+        throw std::runtime_error("failed to find the bounds of the server's stack");
+
+    auto duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(params.duration));
+    deadline = std::chrono::steady_clock::now() + duration;
+    deadlineNanoseconds = monotonicNanoseconds() + std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    outputPath = params.path;
+
+    struct sigaction action
+    {
+    };
+    action.sa_sigaction = onProfilingSignal;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &previousAction);
+
+    setTimer(params.frequency);
+#else
+    (void)params;
+    throw std::runtime_error("profiling is not supported on this platform");
+#endif
+}
+
+std::optional<std::string> Profiler::poll(bool force)
+{
+#ifdef LSP_PROFILER_SUPPORTED
+    if (!isRunning() || (!force && std::chrono::steady_clock::now() < deadline))
+        return std::nullopt;
+
+    // The handler runs on the server thread, so once the timer is disabled and the handler is restored, no more samples are written
+    setTimer(0);
+    sigaction(SIGPROF, &previousAction, nullptr);
+
+    auto path = *outputPath;
+    outputPath = std::nullopt;
+
+    size_t taken = nextSample.load();
+    size_t recorded = std::min(taken, samples.size());
+
+    std::unordered_map<void*, std::string> symbols;
+    std::unordered_map<std::string, size_t> stacks;
+    for (size_t i = 0; i < recorded; i++)
+    {
+        const auto& sample = samples[i];
+
+        // Folded stacks are ordered from the root frame to the leaf frame
+        std::string stack;
+        for (int frame = sample.depth - 1; frame >= 0; frame--)
+        {
+            // Return addresses point to the instruction after the call, which may belong to the next function.
+            // The leaf frame is the interrupted instruction itself
+            auto* address = sample.frames[frame];
+            auto* lookupAddress = frame == 0 ? address : static_cast<char*>(address) - 1;
+
+            auto it = symbols.find(address);
+            if (it == symbols.end())
+                it = symbols.emplace(address, symbolize(lookupAddress)).first;
+
+            if (!stack.empty())
+                stack += ';';
+            stack += it->second;
+        }
+
+        if (!stack.empty())
+            stacks[stack] += 1;
+    }
+
+    std::vector<std::pair<std::string, size_t>> sortedStacks(stacks.begin(), stacks.end());
+    std::sort(sortedStacks.begin(), sortedStacks.end());
+
+    std::ofstream output(path);
+    if (!output)
+        throw std::runtime_error("failed to write profile to " + path.generic_string());
+    for (const auto& [stack, count] : sortedStacks)
+        output << stack << ' ' << count << '\n';
+
+    samples.clear();
+    samples.shrink_to_fit();
+
+    std::string summary = "Wrote profile of " + std::to_string(recorded) + " samples (" + std::to_string(sortedStacks.size()) +
+                          " unique stacks) to " + path.generic_string();
+    if (taken > recorded)
+        summary += ". " + std::to_string(taken - recorded) + " samples were dropped as the sample buffer was full";
+    return summary;
+#else
+    (void)force;
+    return std::nullopt;
+#endif
+}
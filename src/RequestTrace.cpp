@@ -0,0 +1,154 @@
+#include "LSP/RequestTrace.hpp"
+
+#include <sstream>
+
+namespace tracing
+{
+static RequestTrace* activeTrace = nullptr;
+
+static long long toMilliseconds(Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
+
+RequestTrace::RequestTrace(std::string method, Clock::duration queueTime)
+    : method(std::move(method))
+    , queueTime(queueTime)
+    , start(Clock::now())
+{
+}
+
+void RequestTrace::endStep(Clock::time_point now)
+{
+    if (openStep)
+    {
+        spans[*openStep].end = now;
+        openStep = std::nullopt;
+    }
+}
+
+void RequestTrace::beginSpan(std::string name, std::string detail)
+{
+    if (end)
+        return;
+
+    auto now = Clock::now();
+    endStep(now);
+    openSpans.emplace_back(spans.size());
+    spans.emplace_back(Span{std::move(name), std::move(detail), openSpans.size() - 1, now, now});
+}
+
+void RequestTrace::endSpan()
+{
+    if (end || openSpans.empty())
+        return;
+
+    auto now = Clock::now();
+    endStep(now);
+    spans[openSpans.back()].end = now;
+    openSpans.pop_back();
+}
+
+void RequestTrace::step(std::string name, std::string detail)
+{
+    if (end)
+        return;
+
+    auto now = Clock::now();
+    endStep(now);
+    openStep = spans.size();
+    spans.emplace_back(Span{std::move(name), std::move(detail), openSpans.size(), now, now});
+}
+
+Clock::duration RequestTrace::finish()
+{
+    if (!end)
+    {
+        auto now = Clock::now();
+        endStep(now);
+        for (auto index : openSpans)
+            spans[index].end = now;
+        openSpans.clear();
+        end = now;
+    }
+
+    return *end - start;
+}
+
+std::string RequestTrace::format(Clock::duration minimumDuration) const
+{
+    std::stringstream output;
+    output << method << " took " << toMilliseconds((end ? *end : Clock::now()) - start) << "ms\n";
+    output << "  waiting in queue: " << toMilliseconds(queueTime) << "ms\n";
+
+    size_t omitted = 0;
+    for (size_t i = 0; i < spans.size(); i++)
+    {
+        const auto& span = spans[i];
+        auto duration = span.end - span.start;
+
+        // The children of a span are the spans which follow it at the next depth, until we return to its depth
+        auto childrenDuration = Clock::duration::zero();
+        size_t next = i + 1;
+        for (; next < spans.size() && spans[next].depth > span.depth; next++)
+            if (spans[next].depth == span.depth + 1)
+                childrenDuration += spans[next].end - spans[next].start;
+
+        if (duration < minimumDuration)
+        {
+            // Skip the span along with its children
+            omitted += next - i;
+            i = next - 1;
+            continue;
+        }
+
+        output << std::string(2 * (span.depth + 1), ' ') << span.name;
+        if (!span.detail.empty())
+            output << " " << span.detail;
+        output << ": " << toMilliseconds(duration) << "ms";
+        if (childrenDuration > Clock::duration::zero())
+            output << " (self " << toMilliseconds(duration - childrenDuration) << "ms)";
+        output << "\n";
+    }
+
+    if (omitted > 0)
+        output << "  (" << omitted << " spans shorter than " << toMilliseconds(minimumDuration) << "ms omitted)\n";
+
+    return output.str();
+}
+
+RequestTrace* currentTrace()
+{
+    return activeTrace;
+}
+
+ScopedRequestTrace::ScopedRequestTrace(RequestTrace& trace)
+    : previous(activeTrace)
+{
+    activeTrace = &trace;
+}
+
+ScopedRequestTrace::~ScopedRequestTrace()
+{
+    activeTrace = previous;
+}
+
+ScopedSpan::ScopedSpan(std::string name, std::string detail)
+    : trace(activeTrace)
+{
+    if (trace)
+        trace->beginSpan(std::move(name), std::move(detail));
+}
+
+ScopedSpan::~ScopedSpan()
+{
+    if (trace)
+        trace->endSpan();
+}
+
+void step(std::string name, std::string detail)
+{
+    if (activeTrace)
+        activeTrace->step(std::move(name), std::move(detail));
+}
+} // namespace tracing
@@ -0,0 +1,263 @@
+#include "LSP/RequireScanner.hpp"
+
+#include "Luau/Lexer.h"
+
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+
+namespace
+{
+struct Token
+{
+    Luau::Lexeme lexeme;
+    /// The contents of a string literal, with its escape sequences resolved. Left unset for any other lexeme
+    std::optional<std::string> string = std::nullopt;
+};
+
+/// Reads the tokens of the source with the Luau lexer, skipping comments
+std::vector<Token> tokenize(std::string_view source, Luau::AstNameTable& names)
+{
+    std::vector<Token> tokens;
+
+    Luau::Lexer lexer(source.data(), source.size(), names);
+    lexer.setSkipComments(true);
+
+    for (auto lexeme = lexer.next(); lexeme.type != Luau::Lexeme::Eof; lexeme = lexer.next())
+    {
+        Token token{lexeme};
+        if (lexeme.type == Luau::Lexeme::QuotedString)
+        {
+            std::string contents(lexeme.data, lexeme.getLength());
+            if (Luau::Lexer::fixupQuotedString(contents))
+                token.string = std::move(contents);
+        }
+        else if (lexeme.type == Luau::Lexeme::RawString)
+        {
+            std::string contents(lexeme.data, lexeme.getLength());
+            Luau::Lexer::fixupMultilineString(contents);
+            token.string = std::move(contents);
+        }
+        tokens.push_back(std::move(token));
+    }
+
+    return tokens;
+}
+
+class RequireParser
+{
+public:
+    explicit RequireParser(const std::vector<Token>& tokens)
+        : tokens(tokens)
+    {
+    }
+
+    std::vector<ScannedRequire> parse()
+    {
+        std::vector<ScannedRequire> results;
+
+        for (size_t i = 0; i < tokens.size(); i++)
+        {
+            if (isType(i, Luau::Lexeme::ReservedLocal))
+                parseLocal(i);
+            else if (isName(i, "require") && !isSymbol(i - 1, '.') && !isSymbol(i - 1, ':'))
+                if (auto require = parseRequire(i))
+                    results.push_back(std::move(*require));
+        }
+
+        return results;
+    }
+
+private:
+    const std::vector<Token>& tokens;
+    /// The expressions which locals were initialised to, in source order. Scoping is ignored
+    std::unordered_map<std::string, std::vector<RequireExpressionPart>> locals{};
+
+    bool isType(size_t i, Luau::Lexeme::Type type) const
+    {
+        return i < tokens.size() && tokens[i].lexeme.type == type;
+    }
+
+    bool isSymbol(size_t i, char symbol) const
+    {
+        return isType(i, static_cast<Luau::Lexeme::Type>(symbol));
+    }
+
+    bool isName(size_t i, const char* name) const
+    {
+        return isIdentifier(i) && strcmp(tokens[i].lexeme.name, name) == 0;
+    }
+
+    bool isIdentifier(size_t i) const
+    {
+        return isType(i, Luau::Lexeme::Name);
+    }
+
+    bool isKeyword(size_t i) const
+    {
+        return i < tokens.size() && tokens[i].lexeme.type >= Luau::Lexeme::Reserved_BEGIN && tokens[i].lexeme.type < Luau::Lexeme::Reserved_END;
+    }
+
+    bool isString(size_t i) const
+    {
+        return i < tokens.size() && tokens[i].string;
+    }
+
+    /// Parses a require expression starting at the token, returning the index of the token following it
+    std::optional<size_t> parseExpression(size_t i, std::vector<RequireExpressionPart>& parts) const
+    {
+        if (isString(i))
+        {
+            parts.push_back({RequireExpressionPart::Kind::String, *tokens[i].string});
+            return i + 1;
+        }
+
+        if (!isIdentifier(i))
+            return std::nullopt;
+
+        if (auto local = locals.find(tokens[i].lexeme.name); local != locals.end())
+            parts = local->second;
+        else
+            parts.push_back({RequireExpressionPart::Kind::Global, tokens[i].lexeme.name});
+        i += 1;
+
+        while (i < tokens.size())
+        {
+            if (isSymbol(i, '.') && isIdentifier(i + 1))
+            {
+                parts.push_back({RequireExpressionPart::Kind::IndexName, tokens[i + 1].lexeme.name});
+                i += 2;
+            }
+            else if (isSymbol(i, '[') && isString(i + 1) && isSymbol(i + 2, ']'))
+            {
+                parts.push_back({RequireExpressionPart::Kind::IndexString, *tokens[i + 1].string});
+                i += 3;
+            }
+            else if (isSymbol(i, ':') && isIdentifier(i + 1))
+            {
+                // Only method calls with a string literal as their first argument can be resolved
+                std::string method = tokens[i + 1].lexeme.name;
+                if (isString(i + 2))
+                {
+                    parts.push_back({RequireExpressionPart::Kind::MethodCall, method, *tokens[i + 2].string, 1});
+                    i += 3;
+                }
+                else if (isSymbol(i + 2, '(') && isString(i + 3) && (isSymbol(i + 4, ')') || isSymbol(i + 4, ',')))
+                {
+                    size_t argumentCount = 1;
+                    auto closing = findClosingParenthesis(i + 4, &argumentCount);
+                    if (!closing)
+                        return std::nullopt;
+
+                    parts.push_back({RequireExpressionPart::Kind::MethodCall, method, *tokens[i + 3].string, argumentCount});
+                    i = *closing + 1;
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return i;
+    }
+
+    /// Finds the parenthesis closing the call whose arguments continue from the token, counting the arguments passed
+    std::optional<size_t> findClosingParenthesis(size_t i, size_t* argumentCount) const
+    {
+        size_t depth = 0;
+        for (; i < tokens.size(); i++)
+        {
+            if (isSymbol(i, '(') || isSymbol(i, '{') || isSymbol(i, '['))
+            {
+                depth += 1;
+            }
+            else if (isSymbol(i, ')') || isSymbol(i, '}') || isSymbol(i, ']'))
+            {
+                if (depth == 0)
+                    return isSymbol(i, ')') ? std::optional<size_t>(i) : std::nullopt;
+                depth -= 1;
+            }
+            else if (isSymbol(i, ',') && depth == 0 && argumentCount)
+            {
+                *argumentCount += 1;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void parseLocal(size_t i)
+    {
+        // `local function name` and `local a, b = ...` shadow any previous locals of the same name
+        if (isType(i + 1, Luau::Lexeme::ReservedFunction))
+        {
+            if (isIdentifier(i + 2))
+                locals.erase(tokens[i + 2].lexeme.name);
+            return;
+        }
+
+        if (!isIdentifier(i + 1))
+            return;
+
+        std::string name = tokens[i + 1].lexeme.name;
+        if (!isSymbol(i + 2, '='))
+        {
+            for (size_t j = i + 1; isIdentifier(j); j += 2)
+            {
+                locals.erase(tokens[j].lexeme.name);
+                if (!isSymbol(j + 1, ','))
+                    break;
+            }
+            return;
+        }
+
+        // The local is only traced through if it was initialised to exactly the expression, e.g. not `script.Parent.Value + 1`
+        std::vector<RequireExpressionPart> parts;
+        auto end = parseExpression(i + 3, parts);
+        if (end && (*end >= tokens.size() || isIdentifier(*end) || isKeyword(*end) || isSymbol(*end, ';') || isSymbol(*end, ',')))
+            locals.insert_or_assign(name, std::move(parts));
+        else
+            locals.erase(name);
+    }
+
+    std::optional<ScannedRequire> parseRequire(size_t i) const
+    {
+        ScannedRequire require;
+
+        // `require "path"`
+        if (isString(i + 1))
+        {
+            require.expression.push_back({RequireExpressionPart::Kind::String, *tokens[i + 1].string});
+            require.location = Luau::Location{tokens[i].lexeme.location.begin, tokens[i + 1].lexeme.location.end};
+            return require;
+        }
+
+        if (!isSymbol(i + 1, '('))
+            return std::nullopt;
+
+        auto end = parseExpression(i + 2, require.expression);
+        if (!end || !(isSymbol(*end, ')') || isSymbol(*end, ',')))
+            return std::nullopt;
+
+        auto closing = findClosingParenthesis(*end, nullptr);
+        if (!closing)
+            return std::nullopt;
+
+        require.location = Luau::Location{tokens[i].lexeme.location.begin, tokens[*closing].lexeme.location.end};
+        return require;
+    }
+};
+} // namespace
+
+std::vector<ScannedRequire> scanRequires(std::string_view source)
+{
+    // The names read by the lexer are interned into this table, which must outlive the tokens
+    Luau::Allocator allocator;
+    Luau::AstNameTable names(allocator);
+    auto tokens = tokenize(source, names);
+    return RequireParser(tokens).parse();
+}
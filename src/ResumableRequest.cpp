@@ -0,0 +1,65 @@
+#include "LSP/ResumableRequest.hpp"
+
+#include <algorithm>
+
+void RequestScheduler::schedule(const json_rpc::id_type& id, StartFunction start)
+{
+    pending.push_back(PendingRequest{id, std::move(start)});
+}
+
+bool RequestScheduler::empty() const
+{
+    return pending.empty();
+}
+
+const json_rpc::id_type& RequestScheduler::nextId() const
+{
+    return pending.front().id;
+}
+
+void RequestScheduler::resumeNext()
+{
+    if (pending.empty())
+        return;
+
+    // Remove the request whilst it is being resumed, so that an exception drops it
+    auto request = std::move(pending.front());
+    pending.pop_front();
+
+    if (!request.resume)
+        request.resume = request.start();
+
+    if (!request.resume())
+        pending.push_back(std::move(request));
+}
+
+bool RequestScheduler::cancel(const json_rpc::id_type& id)
+{
+    auto it = std::find_if(pending.begin(), pending.end(),
+        [&](const PendingRequest& request)
+        {
+            return request.id == id;
+        });
+    if (it == pending.end())
+        return false;
+
+    pending.erase(it);
+    return true;
+}
+
+std::vector<json_rpc::id_type> RequestScheduler::cancelAll()
+{
+    std::vector<json_rpc::id_type> ids;
+    ids.reserve(pending.size());
+    for (const auto& request : pending)
+        ids.push_back(request.id);
+
+    pending.clear();
+    return ids;
+}
+
+void RequestScheduler::restartAll()
+{
+    for (auto& request : pending)
+        request.resume = nullptr;
+}
@@ -0,0 +1,146 @@
+#include "Analyze/StreamingAnalysis.hpp"
+
+#include "LSP/RequireScanner.hpp"
+#include "LSP/Utils.hpp"
+
+DependencyGraph scanDependencyGraph(WorkspaceFileResolver& fileResolver, const std::vector<std::filesystem::path>& files)
+{
+    DependencyGraph graph;
+
+    std::vector<Luau::ModuleName> queue;
+    queue.reserve(files.size());
+    for (const auto& path : files)
+        queue.push_back(path.generic_string());
+
+    while (!queue.empty())
+    {
+        auto name = std::move(queue.back());
+        queue.pop_back();
+        if (contains(graph.dependencies, name))
+            continue;
+
+        std::vector<Luau::ModuleName> dependencies;
+        if (auto source = fileResolver.readSource(name))
+        {
+            std::unordered_set<Luau::ModuleName> seen;
+            for (const auto& require : scanRequires(source->source))
+            {
+                auto info = fileResolver.resolveRequireExpression(name, require.expression);
+                if (!info || info->name == name || !seen.insert(info->name).second)
+                    continue;
+
+                dependencies.push_back(info->name);
+                graph.dependentCounts[info->name] += 1;
+                queue.push_back(info->name);
+            }
+        }
+        graph.dependencies.emplace(name, std::move(dependencies));
+    }
+
+    return graph;
+}
+
+std::vector<std::filesystem::path> orderByDependencies(const std::vector<std::filesystem::path>& files, const DependencyGraph& graph)
+{
+    std::unordered_map<Luau::ModuleName, std::filesystem::path> filesByName;
+    for (const auto& path : files)
+        filesByName.emplace(path.generic_string(), path);
+
+    std::vector<std::filesystem::path> ordered;
+    ordered.reserve(files.size());
+    std::unordered_set<Luau::ModuleName> visited;
+
+    // A post-order traversal, using an explicit stack as require chains in large projects can be very deep
+    std::vector<std::pair<Luau::ModuleName, size_t>> stack;
+    for (const auto& path : files)
+    {
+        if (visited.insert(path.generic_string()).second)
+            stack.emplace_back(path.generic_string(), 0);
+
+        while (!stack.empty())
+        {
+            auto& [name, nextDependency] = stack.back();
+            if (auto dependencies = graph.dependencies.find(name);
+                dependencies != graph.dependencies.end() && nextDependency < dependencies->second.size())
+            {
+                const auto& dependency = dependencies->second[nextDependency++];
+                if (visited.insert(dependency).second)
+                    stack.emplace_back(dependency, 0);
+                continue;
+            }
+
+            if (auto file = filesByName.find(name); file != filesByName.end())
+                ordered.push_back(file->second);
+            stack.pop_back();
+        }
+    }
+
+    return ordered;
+}
+
+/// Releases everything held for a checked module except its exported interface, which is all that dependents refer to.
+/// The module's source node is left clean, so it is neither parsed nor checked again when a dependent is checked
+static void releaseModule(Luau::Frontend& frontend, const Luau::ModuleName& name)
+{
+    frontend.sourceModules.erase(name);
+
+    if (auto module = frontend.moduleResolver.getModule(name))
+    {
+        module->allocator.reset();
+        module->names.reset();
+        module->errors.clear();
+        module->lintResult = {};
+    }
+}
+
+StreamingReleaser::StreamingReleaser(Luau::Frontend& frontend, const DependencyGraph& graph, const std::vector<std::filesystem::path>& files)
+    : frontend(frontend)
+    , graph(graph)
+    , remainingDependents(graph.dependentCounts)
+{
+    for (const auto& path : files)
+        queued.insert(path.generic_string());
+}
+
+void StreamingReleaser::markChecked(const Luau::ModuleName& root)
+{
+    queued.erase(root);
+
+    std::vector<Luau::ModuleName> newlyChecked;
+    std::vector<Luau::ModuleName> queue{root};
+    while (!queue.empty())
+    {
+        auto name = std::move(queue.back());
+        queue.pop_back();
+        if (contains(queued, name) || !checked.insert(name).second)
+            continue;
+
+        newlyChecked.push_back(name);
+        if (auto dependencies = graph.dependencies.find(name); dependencies != graph.dependencies.end())
+            queue.insert(queue.end(), dependencies->second.begin(), dependencies->second.end());
+    }
+
+    for (const auto& name : newlyChecked)
+    {
+        if (auto dependencies = graph.dependencies.find(name); dependencies != graph.dependencies.end())
+            for (const auto& dependency : dependencies->second)
+                remainingDependents[dependency] -= 1;
+    }
+
+    // A module is released once its last dependent is checked. Any modules checked now without remaining dependents
+    // can be released straight away, as can any previously checked modules whose last dependent was just checked
+    for (const auto& name : newlyChecked)
+    {
+        releaseIfUnneeded(name);
+        if (auto dependencies = graph.dependencies.find(name); dependencies != graph.dependencies.end())
+            for (const auto& dependency : dependencies->second)
+                releaseIfUnneeded(dependency);
+    }
+}
+
+void StreamingReleaser::releaseIfUnneeded(const Luau::ModuleName& name)
+{
+    if (remainingDependents[name] > 0 || checked.find(name) == checked.end() || !released.insert(name).second)
+        return;
+    releaseModule(frontend, name);
+}
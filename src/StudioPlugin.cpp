@@ -11,7 +11,7 @@ void LanguageServer::onStudioPluginFullChange(const PluginNode& dataModel)
     workspace->fileResolver.pluginInfo = std::make_shared<PluginNode>(dataModel);
 
     // Mutate the sourcemap with the new information
-    workspace->updateSourceMap();
+    workspace->updateSourceMap(InvalidationCause::StudioPluginChanged);
 }
 
 void LanguageServer::onStudioPluginClear()
@@ -24,7 +24,7 @@ void LanguageServer::onStudioPluginClear()
     workspace->fileResolver.pluginInfo = nullptr;
 
     // Mutate the sourcemap with the new information
-    workspace->updateSourceMap();
+    workspace->updateSourceMap(InvalidationCause::StudioPluginChanged);
 }
 
 void SourceNode::mutateWithPluginInfo(const PluginNodePtr& pluginInstance)
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <climits>
+#include <cstring>
+#include <algorithm>
 #include "Luau/Common.h"
 #include "Luau/Location.h"
 #include "Luau/StringUtils.h"
@@ -159,6 +161,18 @@ static std::vector<size_t> computeLineOffsets(const std::string& content, bool i
     if (isAtLineStart)
         result = {textOffset};
 
+    const char* begin = content.data();
+    const char* end = begin + content.size();
+
+    // Fast path: if there are no carriage returns, we only need to search for line feeds, which memchr can do far quicker
+    // than checking byte by byte
+    if (std::memchr(begin, '\r', content.size()) == nullptr)
+    {
+        for (const char* it = begin; (it = static_cast<const char*>(std::memchr(it, '\n', end - it))) != nullptr; it++)
+            result.push_back(textOffset + (it - begin) + 1);
+        return result;
+    }
+
     for (size_t i = 0; i < content.size(); i++)
     {
         auto ch = content[i];
@@ -208,7 +222,7 @@ std::string TextDocument::getText(std::optional<lsp::Range> range) const
 std::string TextDocument::getLine(size_t index) const
 {
     LUAU_ASSERT(index < lineCount());
-    auto lineOffsets = getLineOffsets();
+    const auto& lineOffsets = getLineOffsets();
     auto startOffset = lineOffsets[index];
 
     if (index + 1 < lineCount())
@@ -220,7 +234,7 @@ std::string TextDocument::getLine(size_t index) const
 lsp::Position TextDocument::positionAt(size_t offset) const
 {
     offset = std::max(std::min(offset, _content.size()), (size_t)0);
-    auto lineOffsets = getLineOffsets();
+    const auto& lineOffsets = getLineOffsets();
 
     size_t low = 0, high = lineOffsets.size();
     if (high == 0)
@@ -251,7 +265,7 @@ lsp::Position TextDocument::positionAt(size_t offset) const
 size_t TextDocument::offsetAt(const lsp::Position& position) const
 {
     auto utf8Position = convertPosition(position);
-    auto lineOffsets = getLineOffsets();
+    const auto& lineOffsets = getLineOffsets();
     auto lineOffset = lineOffsets[utf8Position.line];
     return lineOffset + utf8Position.column;
 }
@@ -262,7 +276,7 @@ Luau::Position TextDocument::convertPosition(const lsp::Position& position) cons
     LUAU_ASSERT(position.line <= UINT_MAX);
     LUAU_ASSERT(position.character <= UINT_MAX);
 
-    auto lineOffsets = getLineOffsets();
+    const auto& lineOffsets = getLineOffsets();
     if (position.line >= lineCount())
     {
         return Luau::Position{static_cast<unsigned int>(lineOffsets.size() - 1), static_cast<unsigned int>(_content.size() - lineOffsets.back())};
@@ -287,15 +301,104 @@ Luau::Position TextDocument::convertPosition(const lsp::Position& position) cons
 
 lsp::Position TextDocument::convertPosition(const Luau::Position& position) const
 {
-    auto lineOffsets = getLineOffsets();
+    const auto& lineOffsets = getLineOffsets();
     auto line = position.line;
     std::string currentContent = _content.substr(lineOffsets[line], position.column);
     return lsp::Position{line, lspLength(currentContent)};
 }
 
+// Applies a batch of ranged changes in a single pass, rebuilding the content and line offsets once.
+// This is only possible if each change ends before the previous change starts (the order editors send multi-cursor edits in),
+// since the ranges of all the changes then refer to positions in the current content.
+// Positions outside of the current content would be clamped by offsetAt, but may refer to content inserted by an earlier change,
+// so we do not batch them. Likewise, a change ending exactly where an earlier change inserted text is ambiguous.
+// Returns false, without modifying the document, if the changes cannot be batched
+bool TextDocument::applyBatchedChanges(const std::vector<lsp::TextDocumentContentChangeEvent>& changes)
+{
+    struct ResolvedChange
+    {
+        size_t startOffset;
+        size_t endOffset;
+        const std::string* text;
+    };
+
+    std::vector<ResolvedChange> resolved;
+    resolved.reserve(changes.size());
+    for (const auto& change : changes)
+    {
+        if (!change.range)
+            return false;
+
+        auto range = getWellformedRange(*change.range);
+        size_t startOffset = offsetAt(range.start);
+        size_t endOffset = offsetAt(range.end); // End position is EXCLUSIVE
+
+        if (!(positionAt(startOffset) == range.start) || !(positionAt(endOffset) == range.end))
+            return false;
+
+        if (!resolved.empty())
+        {
+            const auto& previous = resolved.back();
+            if (endOffset > previous.startOffset || (endOffset == previous.startOffset && !previous.text->empty()))
+                return false;
+        }
+
+        resolved.push_back(ResolvedChange{startOffset, endOffset, &change.text});
+    }
+
+    // Apply the changes in document order
+    std::reverse(resolved.begin(), resolved.end());
+
+    const auto& offsets = getLineOffsets();
+
+    size_t newSize = _content.size();
+    for (const auto& change : resolved)
+        newSize = newSize + change.text->size() - (change.endOffset - change.startOffset);
+
+    std::string newContent;
+    newContent.reserve(newSize);
+    std::vector<size_t> newOffsets;
+    newOffsets.reserve(offsets.size());
+
+    size_t contentPosition = 0;
+    size_t lineIndex = 0;
+    for (const auto& change : resolved)
+    {
+        // Lines starting in (startOffset, endOffset] have had their line break removed
+        auto firstRemovedLine = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), change.startOffset) - offsets.begin());
+        auto firstRemainingLine = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), change.endOffset) - offsets.begin());
+
+        // Copy over unchanged lines, shifted by the changes before them
+        long diff = static_cast<long>(newContent.size()) - static_cast<long>(contentPosition);
+        for (; lineIndex < firstRemovedLine; lineIndex++)
+            newOffsets.push_back(offsets[lineIndex] + diff);
+        lineIndex = std::max(lineIndex, firstRemainingLine);
+
+        newContent.append(_content, contentPosition, change.startOffset - contentPosition);
+        auto addedLineOffsets = computeLineOffsets(*change.text, false, newContent.size());
+        newOffsets.insert(newOffsets.end(), addedLineOffsets.begin(), addedLineOffsets.end());
+        newContent.append(*change.text);
+        contentPosition = change.endOffset;
+    }
+
+    long diff = static_cast<long>(newContent.size()) - static_cast<long>(contentPosition);
+    for (; lineIndex < offsets.size(); lineIndex++)
+        newOffsets.push_back(offsets[lineIndex] + diff);
+    newContent.append(_content, contentPosition, std::string::npos);
+
+    _content = std::move(newContent);
+    _lineOffsets = std::move(newOffsets);
+    return true;
+}
+
 void TextDocument::update(const std::vector<lsp::TextDocumentContentChangeEvent>& changes, size_t version)
 {
     _version = version;
+
+    // Multi-cursor edits and formatters can send many changes at once, try to apply them together
+    if (changes.size() > 1 && applyBatchedChanges(changes))
+        return;
+
     for (auto& change : changes)
     {
         if (change.range)
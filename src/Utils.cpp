@@ -2,6 +2,8 @@
 #include "Luau/StringUtils.h"
 #include <algorithm>
 #include <fstream>
+#include <cstdint>
+#include <cstdio>
 
 std::optional<std::string> getParentPath(const std::string& path)
 {
@@ -195,3 +197,18 @@ void replaceAll(std::string& str, const std::string& from, const std::string& to
         start_pos += to.length();
     }
 }
+
+std::string hashString(const std::string_view& str)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : str)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(buffer);
+}
@@ -1,5 +1,6 @@
 #include "LSP/Workspace.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "glob/glob.hpp"
@@ -14,7 +15,7 @@ void WorkspaceFolder::openTextDocument(const lsp::DocumentUri& uri, const lsp::D
 
     // Mark the file as dirty as we don't know what changes were made to it
     auto moduleName = fileResolver.getModuleName(uri);
-    frontend.markDirty(moduleName);
+    markDirty(moduleName, InvalidationCause::DocumentOpened);
 }
 
 void WorkspaceFolder::updateTextDocument(
@@ -27,12 +28,58 @@ void WorkspaceFolder::updateTextDocument(
         client->sendLogMessage(lsp::MessageType::Error, "Text Document not loaded locally: " + uri.toString());
         return;
     }
+
+    auto moduleName = fileResolver.getModuleName(uri);
+
+    // Type errors carried over into syntax-only diagnostics are positioned against the previous contents,
+    // so we only keep those which end before every edited region
+    if (auto it = lastTypeErrorDiagnostics.find(moduleName); it != lastTypeErrorDiagnostics.end())
+    {
+        auto& diagnostics = it->second;
+        for (const auto& change : params.contentChanges)
+        {
+            auto isStale = [&change](const lsp::Diagnostic& diagnostic)
+            {
+                return !change.range || !(diagnostic.range.end < std::min(change.range->start, change.range->end));
+            };
+            diagnostics.erase(std::remove_if(diagnostics.begin(), diagnostics.end(), isStale), diagnostics.end());
+        }
+    }
+
     auto& textDocument = fileResolver.managedFiles.at(normalisedUri);
     textDocument.update(params.contentChanges, params.textDocument.version);
 
     // Mark the module dirty for the typechecker
-    auto moduleName = fileResolver.getModuleName(uri);
-    frontend.markDirty(moduleName, markedDirty);
+    auto config = client->getConfiguration(rootUri);
+    if (config.diagnostics.dependentsMode == DependentsModeConfig::OnSave)
+    {
+        // The dependents must still be marked dirty, as rechecking the module frees the types they were checked against.
+        // Only recomputing their diagnostics is deferred until the module is saved
+        std::vector<Luau::ModuleName> invalidated;
+        markDirty(moduleName, InvalidationCause::DocumentChanged, &invalidated);
+
+        auto& dependents = unsavedDependents[moduleName];
+        for (auto& dependent : invalidated)
+        {
+            if (dependent != moduleName && !contains(dependents, dependent))
+                dependents.push_back(std::move(dependent));
+        }
+    }
+    else
+    {
+        markDirty(moduleName, InvalidationCause::DocumentChanged, markedDirty);
+    }
+}
+
+void WorkspaceFolder::saveTextDocument(const lsp::DocumentUri& uri, std::vector<Luau::ModuleName>* deferredDependents)
+{
+    auto it = unsavedDependents.find(fileResolver.getModuleName(uri));
+    if (it == unsavedDependents.end())
+        return;
+
+    if (deferredDependents)
+        deferredDependents->insert(deferredDependents->end(), it->second.begin(), it->second.end());
+    unsavedDependents.erase(it);
 }
 
 void WorkspaceFolder::closeTextDocument(const lsp::DocumentUri& uri)
@@ -42,13 +89,140 @@ void WorkspaceFolder::closeTextDocument(const lsp::DocumentUri& uri)
     // Mark the module as dirty as we no longer track its changes
     auto config = client->getConfiguration(rootUri);
     auto moduleName = fileResolver.getModuleName(uri);
-    frontend.markDirty(moduleName);
+    // Any unsaved changes are discarded, so the diagnostics last reported for the dependents (against the contents on disk) still apply
+    unsavedDependents.erase(moduleName);
+    markDirty(moduleName, InvalidationCause::DocumentClosed);
+
+    lastTypeErrorDiagnostics.erase(moduleName);
+    reportedDiagnostics.erase(uri.toString());
 
     // Refresh workspace diagnostics to clear diagnostics on ignored files
     if (!config.diagnostics.workspace || isIgnoredFile(uri.fsPath()))
         clearDiagnosticsForFile(uri);
 }
 
+size_t WorkspaceFolder::renameFile(const lsp::DocumentUri& oldUri, const lsp::DocumentUri& newUri, std::vector<Luau::ModuleName>* markedDirty)
+{
+    if (oldUri.scheme != "file" || newUri.scheme != "file")
+        return 0;
+
+    auto oldPath = oldUri.fsPath();
+    auto newPath = newUri.fsPath();
+
+    // Collect the files up front, as renaming modifies the source nodes
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> renamedFiles;
+    if (std::filesystem::is_directory(newPath))
+    {
+        for (const auto& [moduleName, _] : frontend.sourceNodes)
+        {
+            auto path = fileResolver.resolveToRealPath(moduleName);
+            if (!path)
+                continue;
+
+            auto relativePath = path->lexically_relative(oldPath);
+            if (relativePath.empty() || *relativePath.begin() == "..")
+                continue;
+
+            renamedFiles.emplace_back(*path, newPath / relativePath);
+        }
+    }
+    else
+    {
+        renamedFiles.emplace_back(oldPath, newPath);
+    }
+
+    size_t remapped = 0;
+    for (const auto& [from, to] : renamedFiles)
+    {
+        auto fromUri = Uri::file(from);
+        auto oldName = fileResolver.getModuleName(fromUri);
+        auto newName = fileResolver.getModuleName(Uri::file(to));
+
+        // Requires are resolved relative to the file's directory, or to its instance in the sourcemap
+        bool keepSyntaxTree =
+            from.parent_path() == to.parent_path() && !WorkspaceFileResolver::isVirtualPath(oldName) && !WorkspaceFileResolver::isVirtualPath(newName);
+        if (renameModule(oldName, newName, keepSyntaxTree, markedDirty))
+            remapped += 1;
+
+        lastTypeErrorDiagnostics.erase(oldName);
+        reportedDiagnostics.erase(fromUri.toString());
+        clearDiagnosticsForFile(fromUri);
+    }
+
+    return remapped;
+}
+
+// The syntax tree, require graph and check results of the module are moved to its new name rather than discarded.
+// Modules which required the old name no longer resolve it, and modules which required the new name now do, so both are invalidated.
+// The module itself is rechecked, as its types record the name of the module they were defined in
+bool WorkspaceFolder::renameModule(
+    const Luau::ModuleName& oldName, const Luau::ModuleName& newName, bool keepSyntaxTree, std::vector<Luau::ModuleName>* markedDirty)
+{
+    if (oldName == newName)
+        return false;
+
+    // If the old module is unknown, then it was never indexed, or it has already been renamed
+    // (e.g. by `workspace/didRenameFiles`, before the file watcher reported the same rename)
+    auto it = frontend.sourceNodes.find(oldName);
+    if (it == frontend.sourceNodes.end())
+        return false;
+
+    markDirty(oldName, InvalidationCause::FileRenamed, markedDirty);
+
+    // The new module was loaded independently (e.g. by opening the renamed document), so we treat the old module as deleted
+    if (contains(frontend.sourceNodes, newName))
+        return false;
+
+    auto sourceNode = it->second;
+    frontend.sourceNodes.erase(it);
+    sourceNode->name = newName;
+    sourceNode->humanReadableName = fileResolver.getHumanReadableModuleName(newName);
+    frontend.sourceNodes.emplace(newName, sourceNode);
+
+    bool hasSyntaxTree = false;
+    if (auto sourceModuleIt = frontend.sourceModules.find(oldName); sourceModuleIt != frontend.sourceModules.end())
+    {
+        auto sourceModule = sourceModuleIt->second;
+        frontend.sourceModules.erase(sourceModuleIt);
+        if (sourceModule)
+        {
+            sourceModule->name = newName;
+            sourceModule->humanReadableName = sourceNode->humanReadableName;
+            frontend.sourceModules.emplace(newName, sourceModule);
+            hasSyntaxTree = true;
+        }
+    }
+
+    for (auto* resolver : {&frontend.moduleResolver, &frontend.moduleResolverForAutocomplete})
+    {
+        if (auto module = resolver->getModule(oldName))
+        {
+            resolver->setModule(newName, module);
+            resolver->setModule(oldName, nullptr);
+        }
+    }
+
+    markDirty(newName, InvalidationCause::FileRenamed, markedDirty);
+
+    // Marking the module dirty also marks it for reparsing, which we can skip if its requires still resolve to the same modules
+    if (keepSyntaxTree && hasSyntaxTree)
+        sourceNode->dirtySourceModule = false;
+
+    return true;
+}
+
+void WorkspaceFolder::markDirty(const Luau::ModuleName& moduleName, InvalidationCause cause, std::vector<Luau::ModuleName>* markedDirty)
+{
+    std::vector<Luau::ModuleName> invalidated;
+    frontend.markDirty(moduleName, &invalidated);
+    if (!interfaceStubs.empty())
+        releaseInvalidatedInterfaceStubs(invalidated);
+    invalidationLog.record(cause, moduleName, invalidated);
+
+    if (markedDirty)
+        markedDirty->insert(markedDirty->end(), invalidated.begin(), invalidated.end());
+}
+
 void WorkspaceFolder::clearDiagnosticsForFile(const lsp::DocumentUri& uri)
 {
     if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
@@ -87,6 +261,12 @@ bool WorkspaceFolder::isIgnoredFile(const std::filesystem::path& path, const std
     return false;
 }
 
+DirectoryWalkRules WorkspaceFolder::getDirectoryWalkRules(const ClientConfiguration& config)
+{
+    auto root = rootUri.fsPath();
+    return DirectoryWalkRules{root, GlobSet(config.ignoreGlobs), GlobSet(config.respectGitignore ? readGitignoreGlobs(root) : std::vector<std::string>{})};
+}
+
 bool WorkspaceFolder::isDefinitionFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig)
 {
     auto config = givenConfig ? *givenConfig : client->getConfiguration(rootUri);
@@ -112,6 +292,7 @@ Luau::CheckResult WorkspaceFolder::checkSimple(const Luau::ModuleName& moduleNam
 {
     try
     {
+        checkCount += 1;
         return frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ false, /* forAutocomplete: */ false, runLintChecks});
     }
     catch (Luau::InternalCompilerError& err)
@@ -134,13 +315,299 @@ void WorkspaceFolder::checkStrict(const Luau::ModuleName& moduleName, bool forAu
     // and then a call `Frontend::check(moduleName, { retainTypeGraphs: true })` will NOT actually
     // retain the type graph if the module is not marked dirty.
     // We do a manual check and dirty marking to fix this
+    tracing::ScopedSpan span("checkStrict", moduleName);
+
+    if (forAutocomplete)
+        ensureAutocompleteGlobals();
+
+    // Features retrieving the type graph need the definitions and documentation of the real dependencies, not their interfaces
+    releaseInterfaceStubs();
+
     auto module = forAutocomplete ? frontend.moduleResolverForAutocomplete.getModule(moduleName) : frontend.moduleResolver.getModule(moduleName);
     if (module && module->internalTypes.types.empty()) // If we didn't retain type graphs, then the internalTypes arena is empty
-        frontend.markDirty(moduleName);
+        markDirty(moduleName, InvalidationCause::TypeGraphNotRetained);
 
+    checkCount += 1;
     frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, forAutocomplete, /* runLintChecks: */ false});
 }
 
+std::shared_ptr<const ScopeIndex> WorkspaceFolder::getScopeIndex(const Luau::ModulePtr& module)
+{
+    if (auto it = scopeIndexes.find(module.get());
+        it != scopeIndexes.end() && it->second.module.lock() == module && it->second.index->size() == module->scopes.size())
+        return it->second.index;
+
+    // Drop the indexes of modules which have since been rechecked, so that we don't hold onto their scopes
+    for (auto it = scopeIndexes.begin(); it != scopeIndexes.end();)
+    {
+        if (it->second.module.expired())
+            it = scopeIndexes.erase(it);
+        else
+            ++it;
+    }
+
+    auto index = std::make_shared<const ScopeIndex>(*module);
+    scopeIndexes.insert_or_assign(module.get(), CachedScopeIndex{module, index});
+    return index;
+}
+
+OperationCounts WorkspaceFolder::getOperationCounts() const
+{
+    OperationCounts counts;
+    counts.checks = checkCount;
+    counts.modulesChecked = frontend.stats.filesStrict + frontend.stats.filesNonstrict;
+    counts.parses = frontend.stats.files;
+    counts.sourceReads = fileResolver.sourceReadCount;
+    counts.sourcemapUpdates = sourcemapUpdateCount;
+    counts.completionTableBuilds = completionTableBuildCount;
+    return counts;
+}
+
+// Approximate sizes used to estimate the memory held by caches. These only need to be accurate enough to decide how much to release
+static constexpr size_t ESTIMATED_SYNTAX_TREE_BYTES_PER_LINE = 512;
+static constexpr size_t ESTIMATED_AST_TYPE_ENTRY_BYTES = 32;
+
+static size_t estimateTypeGraphSize(const Luau::Module& module)
+{
+    size_t astTypeEntries = module.astTypes.size() + module.astTypePacks.size() + module.astExpectedTypes.size() +
+                            module.astOriginalCallTypes.size() + module.astOverloadResolvedTypes.size() + module.astResolvedTypes.size() +
+                            module.astResolvedTypePacks.size();
+    return module.internalTypes.types.size() * sizeof(Luau::Type) + module.internalTypes.typePacks.size() * sizeof(Luau::TypePackVar) +
+           astTypeEntries * ESTIMATED_AST_TYPE_ENTRY_BYTES + module.scopes.size() * sizeof(Luau::Scope);
+}
+
+static size_t estimateSyntaxTreeSize(const Luau::SourceModule& sourceModule)
+{
+    if (!sourceModule.root)
+        return 0;
+    return (sourceModule.root->location.end.line + 1) * ESTIMATED_SYNTAX_TREE_BYTES_PER_LINE;
+}
+
+static size_t estimateDiagnosticsSize(const std::vector<lsp::Diagnostic>& diagnostics)
+{
+    size_t size = diagnostics.capacity() * sizeof(lsp::Diagnostic);
+    for (const auto& diagnostic : diagnostics)
+        size += diagnostic.message.capacity();
+    return size;
+}
+
+// Releases the type graph of the module in the same way as `Frontend::check` does when `retainFullTypeGraphs` is false.
+// Dependents only refer to the public interface of a module, which is kept separately in its interfaceTypes arena
+static void releaseTypeGraph(Luau::Module& module)
+{
+    module.internalTypes.clear();
+    module.astTypes.clear();
+    module.astTypePacks.clear();
+    module.astExpectedTypes.clear();
+    module.astOriginalCallTypes.clear();
+    module.astOverloadResolvedTypes.clear();
+    module.astResolvedTypes.clear();
+    module.astResolvedTypePacks.clear();
+    module.scopes.clear();
+}
+
+// The diagnostics type checker retains the full type graph of every module it checks, but only features operating on open documents read it.
+// We release the graphs of closed modules once there is no more background work to do.
+// Modules with errors are skipped, as their errors may refer to types in the graph and are reported again when checking dependents.
+// If the graph is needed again, `checkStrict` will recheck the module as its internalTypes arena is empty. This marks the module dirty,
+// rechecking all of its dependents too (see luau#975), so we also keep the graphs of every module required by an open document
+size_t WorkspaceFolder::compactTypeGraphs()
+{
+    if (!hasUncompactedTypeGraphs)
+        return 0;
+    hasUncompactedTypeGraphs = false;
+
+    std::unordered_set<Luau::ModuleName> requiredByOpenDocuments;
+    std::vector<Luau::ModuleName> queue;
+    for (const auto& [_, document] : fileResolver.managedFiles)
+        queue.push_back(fileResolver.getModuleName(document.uri()));
+    while (!queue.empty())
+    {
+        auto next = std::move(queue.back());
+        queue.pop_back();
+
+        auto it = frontend.sourceNodes.find(next);
+        if (it == frontend.sourceNodes.end())
+            continue;
+
+        for (const auto& dependency : it->second->requireSet)
+            if (requiredByOpenDocuments.insert(dependency).second)
+                queue.push_back(dependency);
+    }
+
+    size_t compacted = 0;
+    for (const auto& [moduleName, _] : frontend.sourceNodes)
+    {
+        if (frontend.isDirty(moduleName) || fileResolver.getTextDocumentFromModuleName(moduleName) || contains(requiredByOpenDocuments, moduleName))
+            continue;
+
+        auto module = frontend.moduleResolver.getModule(moduleName);
+        if (!module || module->internalTypes.types.empty() || !module->errors.empty())
+            continue;
+
+        releaseTypeGraph(*module);
+        scopeIndexes.erase(module.get());
+
+        compacted += 1;
+    }
+
+    return compacted;
+}
+
+CacheUsage WorkspaceFolder::estimateCacheUsage()
+{
+    CacheUsage usage;
+
+    for (const auto& [_, reported] : reportedDiagnostics)
+        usage.results += estimateDiagnosticsSize(reported.items);
+    for (const auto& [_, diagnostics] : lastTypeErrorDiagnostics)
+        usage.results += estimateDiagnosticsSize(diagnostics);
+    for (const auto& [_, cached] : scopeIndexes)
+        usage.results += cached.index->memoryUsage();
+
+    for (const auto& [_, sourceModule] : frontend.sourceModules)
+        if (sourceModule)
+            usage.syntaxTrees += estimateSyntaxTreeSize(*sourceModule);
+
+    for (const auto& [moduleName, _] : frontend.sourceNodes)
+    {
+        if (auto module = frontend.moduleResolver.getModule(moduleName))
+            usage.typeGraphs += estimateTypeGraphSize(*module);
+        if (auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName))
+            usage.typeGraphs += estimateTypeGraphSize(*module);
+    }
+
+    return usage;
+}
+
+size_t WorkspaceFolder::releaseCache(CacheKind kind)
+{
+    size_t released = 0;
+
+    switch (kind)
+    {
+    case CacheKind::Results:
+    {
+        // Without the previously reported diagnostics, the next report is sent in full rather than marked as unchanged
+        for (const auto& [_, reported] : reportedDiagnostics)
+            released += estimateDiagnosticsSize(reported.items);
+        for (const auto& [_, diagnostics] : lastTypeErrorDiagnostics)
+            released += estimateDiagnosticsSize(diagnostics);
+        for (const auto& [_, cached] : scopeIndexes)
+            released += cached.index->memoryUsage();
+
+        reportedDiagnostics.clear();
+        lastTypeErrorDiagnostics.clear();
+        scopeIndexes.clear();
+        break;
+    }
+    case CacheKind::SyntaxTrees:
+    {
+        for (auto& [moduleName, sourceNode] : frontend.sourceNodes)
+        {
+            if (frontend.isDirty(moduleName) || fileResolver.getTextDocumentFromModuleName(moduleName))
+                continue;
+
+            auto sourceModule = frontend.sourceModules.find(moduleName);
+            if (sourceModule == frontend.sourceModules.end() || !sourceModule->second)
+                continue;
+
+            // The type graphs refer to nodes in the syntax tree, so it can only be released once neither type checker retains a graph
+            auto module = frontend.moduleResolver.getModule(moduleName);
+            auto autocompleteModule = frontend.moduleResolverForAutocomplete.getModule(moduleName);
+            if ((module && !module->internalTypes.types.empty()) || (autocompleteModule && !autocompleteModule->internalTypes.types.empty()))
+                continue;
+
+            // Modules hold onto the allocator of their syntax tree for as long as they are alive
+            for (const auto& checkedModule : {module, autocompleteModule})
+            {
+                if (checkedModule)
+                {
+                    checkedModule->allocator.reset();
+                    checkedModule->names.reset();
+                }
+            }
+
+            released += estimateSyntaxTreeSize(*sourceModule->second);
+            frontend.sourceModules.erase(sourceModule);
+
+            // The frontend reparses the module the next time it is part of a check. Its type checking results are unaffected
+            sourceNode->dirtySourceModule = true;
+        }
+        break;
+    }
+    case CacheKind::TypeGraphs:
+    {
+        for (const auto& [moduleName, _] : frontend.sourceNodes)
+        {
+            if (frontend.isDirty(moduleName) || fileResolver.getTextDocumentFromModuleName(moduleName))
+                continue;
+
+            for (const auto& module : {frontend.moduleResolver.getModule(moduleName), frontend.moduleResolverForAutocomplete.getModule(moduleName)})
+            {
+                if (!module || module->internalTypes.types.empty() || !module->errors.empty())
+                    continue;
+
+                released += estimateTypeGraphSize(*module);
+                releaseTypeGraph(*module);
+                scopeIndexes.erase(module.get());
+            }
+        }
+        break;
+    }
+    }
+
+    return released;
+}
+
+Luau::SourceModule* WorkspaceFolder::getSourceModule(const Luau::ModuleName& moduleName)
+{
+    if (auto sourceModule = frontend.getSourceModule(moduleName))
+        return sourceModule;
+
+    // A module with a source node but no syntax tree had its tree released under memory pressure
+    auto it = frontend.sourceNodes.find(moduleName);
+    if (it == frontend.sourceNodes.end() || !it->second->hasDirtySourceModule())
+        return nullptr;
+
+    // `Frontend::parse` skips modules which do not need rechecking, but we only need the syntax tree back.
+    // The module's type checking results remain valid, as its source has not changed since it was released
+    auto& sourceNode = *it->second;
+    bool dirtyModule = sourceNode.dirtyModule;
+    sourceNode.dirtyModule = true;
+    frontend.parse(moduleName);
+    sourceNode.dirtyModule = dirtyModule;
+
+    return frontend.getSourceModule(moduleName);
+}
+
+/// Seeds the dependency graph with the module's requires, found by scanning its tokens instead of parsing it.
+/// The source node is left with a dirty source module, so the module is fully parsed the first time a feature needs it
+void WorkspaceFolder::indexModule(const Luau::ModuleName& moduleName)
+{
+    if (contains(frontend.sourceNodes, moduleName))
+        return;
+
+    auto source = fileResolver.readSource(moduleName);
+    if (!source)
+        return;
+
+    auto sourceNode = std::make_shared<Luau::SourceNode>();
+    sourceNode->name = moduleName;
+    sourceNode->humanReadableName = fileResolver.getHumanReadableModuleName(moduleName);
+
+    for (const auto& require : scanRequires(source->source))
+    {
+        if (auto info = fileResolver.resolveRequireExpression(moduleName, require.expression))
+        {
+            sourceNode->requireSet.insert(info->name);
+            sourceNode->requireLocations.emplace_back(info->name, require.location);
+        }
+    }
+
+    frontend.sourceNodes.emplace(moduleName, std::move(sourceNode));
+}
+
 void WorkspaceFolder::indexFiles(const ClientConfiguration& config)
 {
     if (!config.index.enabled)
@@ -151,35 +618,34 @@ void WorkspaceFolder::indexFiles(const ClientConfiguration& config)
 
     size_t indexCount = 0;
 
-    for (std::filesystem::recursive_directory_iterator next(rootUri.fsPath()), end; next != end; ++next)
-    {
-        if (indexCount >= config.index.maxFiles)
+    walkSourceFiles(rootUri.fsPath(), getDirectoryWalkRules(config),
+        [&](const std::filesystem::path& path)
         {
-            client->sendWindowMessage(lsp::MessageType::Warning, "The maximum workspace index limit (" + std::to_string(config.index.maxFiles) +
-                                                                     ") has been hit. This may cause some language features to only work partially "
-                                                                     "(Find All References, Rename). If necessary, consider increasing the limit");
-            break;
-        }
+            if (indexCount >= config.index.maxFiles)
+            {
+                client->sendWindowMessage(lsp::MessageType::Warning,
+                    "The maximum workspace index limit (" + std::to_string(config.index.maxFiles) +
+                        ") has been hit. This may cause some language features to only work partially "
+                        "(Find All References, Rename). If necessary, consider increasing the limit");
+                return false;
+            }
 
-        if (next->is_regular_file() && next->path().has_extension() && !isDefinitionFile(next->path(), config) &&
-            !isIgnoredFile(next->path(), config))
-        {
-            auto ext = next->path().extension();
-            if (ext == ".lua" || ext == ".luau")
+            if (!isDefinitionFile(path, config) && !isIgnoredFile(path, config))
             {
-                auto moduleName = fileResolver.getModuleName(Uri::file(next->path()));
+                auto moduleName = fileResolver.getModuleName(Uri::file(path));
 
-                // Parse the module to infer require data
-                // We do not perform any type checking here
-                frontend.parse(moduleName);
+                // Scan the module for its requires to build the dependency graph
+                // We do not parse or type check it here
+                indexModule(moduleName);
 
                 indexCount += 1;
             }
-        }
-    }
+
+            return true;
+        });
 }
 
-bool WorkspaceFolder::updateSourceMap()
+bool WorkspaceFolder::updateSourceMap(InvalidationCause cause)
 {
     auto sourcemapPath = rootUri.fsPath() / "sourcemap.json";
     client->sendTrace("Updating sourcemap contents from " + sourcemapPath.generic_string());
@@ -188,19 +654,28 @@ bool WorkspaceFolder::updateSourceMap()
     // TODO: we assume a sourcemap.json file in the workspace root
     if (auto sourceMapContents = readFile(sourcemapPath))
     {
+        sourcemapUpdateCount += 1;
+        // Nothing has been invalidated if no modules have been loaded yet (e.g. when first configuring the workspace)
+        if (!frontend.sourceNodes.empty())
+            invalidationLog.recordWorkspace(cause);
         frontend.clear();
+        interfaceStubs.clear();
+        fileResolver.interfaceStubs.clear();
         fileResolver.updateSourceMap(sourceMapContents.value());
 
         // Recreate instance types
         auto config = client->getConfiguration(rootUri);
         instanceTypes.clear();
+        completionTables.reset();
         // NOTE: expressive types is always enabled for autocomplete, regardless of the setting!
         // We pass the same setting even when we are registering autocomplete globals since
         // the setting impacts what happens to diagnostics (as both calls overwrite frontend.prepareModuleScope)
-        types::registerInstanceTypes(frontend, frontend.globals, instanceTypes, fileResolver,
-            /* expressiveTypes: */ config.diagnostics.strictDatamodelTypes);
-        types::registerInstanceTypes(frontend, frontend.globalsForAutocomplete, instanceTypes, fileResolver,
+        types::registerInstanceTypes(frontend, frontend.globals, instanceTypes, fileResolver, deferredInstanceChildren,
             /* expressiveTypes: */ config.diagnostics.strictDatamodelTypes);
+        if (hasAutocompleteGlobals)
+            types::registerInstanceTypes(frontend, frontend.globalsForAutocomplete, instanceTypes, fileResolver, deferredInstanceChildren,
+                /* expressiveTypes: */ config.diagnostics.strictDatamodelTypes);
+        traceModuleChecks();
 
         return true;
     }
@@ -210,13 +685,73 @@ bool WorkspaceFolder::updateSourceMap()
     }
 }
 
-void WorkspaceFolder::initialize()
+// Type checking the definitions files dominates startup time and their types make up most of the resident memory of the globals.
+// The autocomplete type checker keeps its own copy, which is only used by features other than diagnostics. We build it as background work
+// once there are no diagnostics pending, or on first use if a feature needs it sooner. The definitions cannot be loaded class by class,
+// as the definitions loader resolves every declaration in a file against the scope together
+bool WorkspaceFolder::ensureAutocompleteGlobals()
 {
-    Luau::registerBuiltinGlobals(frontend, frontend.globals, /* typeCheckForAutocomplete = */ false);
+    if (hasAutocompleteGlobals)
+        return false;
+    hasAutocompleteGlobals = true;
+
+    Luau::unfreeze(frontend.globalsForAutocomplete.globalTypes);
     Luau::registerBuiltinGlobals(frontend, frontend.globalsForAutocomplete, /* typeCheckForAutocomplete = */ true);
 
     Luau::attachTag(Luau::getGlobalBinding(frontend.globalsForAutocomplete, "require"), "Require");
 
+    // Any errors in the definitions files were already reported when loading them into the diagnostics globals
+    for (const auto& [definitionsContents, metadata] : pendingAutocompleteDefinitions)
+        types::registerDefinitions(frontend, frontend.globalsForAutocomplete, definitionsContents, /* typeCheckForAutocomplete = */ true, metadata);
+    pendingAutocompleteDefinitions.clear();
+    pendingAutocompleteDefinitions.shrink_to_fit();
+
+    // Instance types from the sourcemap may have been registered before the environment existed
+    if (fileResolver.rootSourceNode)
+    {
+        auto config = client->getConfiguration(rootUri);
+        types::registerInstanceTypes(frontend, frontend.globalsForAutocomplete, instanceTypes, fileResolver, deferredInstanceChildren,
+            /* expressiveTypes: */ config.diagnostics.strictDatamodelTypes);
+        traceModuleChecks();
+    }
+
+    Luau::freeze(frontend.globalsForAutocomplete.globalTypes);
+    completionTables.reset();
+    return true;
+}
+
+// Records each module type checked within a request, along with why it needed checking.
+// Registering instance types replaces `prepareModuleScope`, so this wraps whichever is current and must be reapplied after each registration
+struct TracedPrepareModuleScope
+{
+    const InvalidationLog* invalidationLog;
+    decltype(Luau::Frontend::prepareModuleScope) prepareModuleScope;
+
+    void operator()(const Luau::ModuleName& name, const Luau::ScopePtr& scope, bool forAutocomplete) const
+    {
+        // Only describe the module when a request is being traced, as this runs for every module check
+        if (tracing::currentTrace())
+            tracing::step(forAutocomplete ? "check (autocomplete)" : "check", describeCheckedModule(*invalidationLog, name));
+        if (prepareModuleScope)
+            prepareModuleScope(name, scope, forAutocomplete);
+    }
+};
+
+void WorkspaceFolder::traceModuleChecks()
+{
+    // Registering instance types returns early without replacing the callback if there is no sourcemap, in which case it is already wrapped
+    if (frontend.prepareModuleScope.target<TracedPrepareModuleScope>())
+        return;
+
+    frontend.prepareModuleScope = TracedPrepareModuleScope{&invalidationLog, std::move(frontend.prepareModuleScope)};
+}
+
+void WorkspaceFolder::initialize()
+{
+    traceModuleChecks();
+
+    Luau::registerBuiltinGlobals(frontend, frontend.globals, /* typeCheckForAutocomplete = */ false);
+
     if (client->definitionsFiles.empty())
     {
         client->sendLogMessage(lsp::MessageType::Warning, "No definitions file provided by client");
@@ -234,14 +769,15 @@ void WorkspaceFolder::initialize()
             continue;
         }
 
+        definitionsHash = hashString(definitionsHash + hashString(*definitionsContents));
+
         // Parse definitions file metadata
         if (auto metadata = types::parseDefinitionsFileMetadata(*definitionsContents))
             definitionsFileMetadata = metadata;
 
         auto result = types::registerDefinitions(
             frontend, frontend.globals, *definitionsContents, /* typeCheckForAutocomplete = */ false, definitionsFileMetadata);
-        types::registerDefinitions(
-            frontend, frontend.globalsForAutocomplete, *definitionsContents, /* typeCheckForAutocomplete = */ true, definitionsFileMetadata);
+        pendingAutocompleteDefinitions.emplace_back(*definitionsContents, definitionsFileMetadata);
 
         auto uri = Uri::file(definitionsFile);
 
@@ -268,15 +804,23 @@ void WorkspaceFolder::initialize()
         }
     }
     Luau::freeze(frontend.globals.globalTypes);
-    Luau::freeze(frontend.globalsForAutocomplete.globalTypes);
+
+    if (client->cacheDirectory && !isNullWorkspace())
+    {
+        auto workspaceHash = hashString(rootUri.toString());
+        diagnosticsCache.load(*client->cacheDirectory / ("diagnostics-" + workspaceHash + ".json"));
+        moduleInterfaceCache.load(*client->cacheDirectory / ("interfaces-" + workspaceHash + ".json"));
+    }
 }
 
 void WorkspaceFolder::setupWithConfiguration(const ClientConfiguration& configuration)
 {
     isConfigured = true;
+    // Which files are packages depends on the configuration
+    fileResolver.clearConfigCache();
     if (configuration.sourcemap.enabled)
     {
-        if (!isNullWorkspace() && !updateSourceMap())
+        if (!isNullWorkspace() && !updateSourceMap(InvalidationCause::ConfigurationChanged))
         {
             client->sendWindowMessage(
                 lsp::MessageType::Error, "Failed to load sourcemap.json for workspace '" + name + "'. Instance information will not be available");
@@ -5,6 +5,7 @@
 #include "Luau/Ast.h"
 #include "LSP/WorkspaceFileResolver.hpp"
 #include "LSP/Utils.hpp"
+#include "glob/glob.hpp"
 
 Luau::ModuleName WorkspaceFileResolver::getModuleName(const Uri& name) const
 {
@@ -136,6 +137,11 @@ std::optional<std::filesystem::path> WorkspaceFileResolver::resolveToRealPath(co
 
 std::optional<Luau::SourceCode> WorkspaceFileResolver::readSource(const Luau::ModuleName& name)
 {
+    sourceReadCount += 1;
+
+    if (auto stub = interfaceStubs.find(name); stub != interfaceStubs.end())
+        return Luau::SourceCode{stub->second, Luau::SourceCode::Type::Module};
+
     Luau::SourceCode::Type sourceType = Luau::SourceCode::Type::None;
     std::optional<std::string> source;
 
@@ -300,6 +306,62 @@ std::optional<Luau::ModuleInfo> WorkspaceFileResolver::resolveStringRequire(cons
     return {{Uri::parse(Uri::file(filePath).toString()).fsPath().generic_string()}};
 }
 
+static std::optional<Luau::ModuleInfo> resolveIndex(const Luau::ModuleInfo* context, const std::string& index, bool isIndexName)
+{
+    if (!context)
+        return std::nullopt;
+
+    if (isIndexName && index == "Parent")
+    {
+        // Pop the name instead
+        auto parentPath = getParentPath(context->name);
+        if (parentPath.has_value())
+            return Luau::ModuleInfo{parentPath.value(), context->optional};
+    }
+
+    return Luau::ModuleInfo{mapContext(context->name) + '/' + index, context->optional};
+}
+
+static std::optional<Luau::ModuleInfo> resolveMethodCall(
+    const Luau::ModuleInfo* context, const std::string& method, const std::string& argument, size_t argumentCount)
+{
+    if (!context || argumentCount < 1)
+        return std::nullopt;
+
+    if (method == "GetService" && context->name == "game")
+    {
+        return Luau::ModuleInfo{"game/" + argument};
+    }
+    else if (method == "WaitForChild" || (method == "FindFirstChild" && argumentCount == 1)) // Don't allow recursive FFC
+    {
+        return Luau::ModuleInfo{mapContext(context->name) + '/' + argument, context->optional};
+    }
+    else if (method == "FindFirstAncestor")
+    {
+        auto ancestorName = getAncestorPath(context->name, argument);
+        if (ancestorName)
+            return Luau::ModuleInfo{*ancestorName, context->optional};
+    }
+
+    return std::nullopt;
+}
+
+std::optional<Luau::ModuleInfo> WorkspaceFileResolver::resolveGlobal(const Luau::ModuleInfo* context, const std::string& name) const
+{
+    if (name == "game")
+        return Luau::ModuleInfo{"game"};
+
+    if (name == "script")
+    {
+        if (auto virtualPath = resolveToVirtualPath(context->name))
+        {
+            return Luau::ModuleInfo{virtualPath.value()};
+        }
+    }
+
+    return std::nullopt;
+}
+
 std::optional<Luau::ModuleInfo> WorkspaceFileResolver::resolveModule(const Luau::ModuleInfo* context, Luau::AstExpr* node)
 {
     // Handle require("path") for compatibility
@@ -310,66 +372,68 @@ std::optional<Luau::ModuleInfo> WorkspaceFileResolver::resolveModule(const Luau:
     }
     else if (auto* g = node->as<Luau::AstExprGlobal>())
     {
-        if (g->name == "game")
-            return Luau::ModuleInfo{"game"};
-
-        if (g->name == "script")
-        {
-            if (auto virtualPath = resolveToVirtualPath(context->name))
-            {
-                return Luau::ModuleInfo{virtualPath.value()};
-            }
-        }
+        return resolveGlobal(context, g->name.value);
     }
     else if (auto* i = node->as<Luau::AstExprIndexName>())
     {
-        if (context)
-        {
-            if (strcmp(i->index.value, "Parent") == 0)
-            {
-                // Pop the name instead
-                auto parentPath = getParentPath(context->name);
-                if (parentPath.has_value())
-                    return Luau::ModuleInfo{parentPath.value(), context->optional};
-            }
-
-            return Luau::ModuleInfo{mapContext(context->name) + '/' + i->index.value, context->optional};
-        }
+        return resolveIndex(context, i->index.value, /* isIndexName: */ true);
     }
     else if (auto* i_expr = node->as<Luau::AstExprIndexExpr>())
     {
         if (auto* index = i_expr->index->as<Luau::AstExprConstantString>())
-        {
-            if (context)
-                return Luau::ModuleInfo{mapContext(context->name) + '/' + std::string(index->value.data, index->value.size), context->optional};
-        }
+            return resolveIndex(context, std::string(index->value.data, index->value.size), /* isIndexName: */ false);
     }
     else if (auto* call = node->as<Luau::AstExprCall>(); call && call->self && call->args.size >= 1 && context)
     {
         if (auto* index = call->args.data[0]->as<Luau::AstExprConstantString>())
         {
             Luau::AstName func = call->func->as<Luau::AstExprIndexName>()->index;
-
-            if (func == "GetService" && context->name == "game")
-            {
-                return Luau::ModuleInfo{"game/" + std::string(index->value.data, index->value.size)};
-            }
-            else if (func == "WaitForChild" || (func == "FindFirstChild" && call->args.size == 1)) // Don't allow recursive FFC
-            {
-                return Luau::ModuleInfo{mapContext(context->name) + '/' + std::string(index->value.data, index->value.size), context->optional};
-            }
-            else if (func == "FindFirstAncestor")
-            {
-                auto ancestorName = getAncestorPath(context->name, std::string(index->value.data, index->value.size));
-                if (ancestorName)
-                    return Luau::ModuleInfo{*ancestorName, context->optional};
-            }
+            return resolveMethodCall(context, func.value, std::string(index->value.data, index->value.size), call->args.size);
         }
     }
 
     return std::nullopt;
 }
 
+std::optional<Luau::ModuleInfo> WorkspaceFileResolver::resolveRequireExpression(
+    const Luau::ModuleName& currentModule, const std::vector<RequireExpressionPart>& expression) const
+{
+    if (expression.empty())
+        return std::nullopt;
+
+    // Matches the RequireTracer: the first part is resolved relative to the current module, and each following part relative to the
+    // result of the previous part
+    Luau::ModuleInfo currentContext{currentModule};
+    std::optional<Luau::ModuleInfo> info = std::nullopt;
+    for (const auto& part : expression)
+    {
+        const Luau::ModuleInfo* context = info ? &*info : &currentContext;
+        switch (part.kind)
+        {
+        case RequireExpressionPart::Kind::String:
+            info = info ? std::nullopt : resolveStringRequire(context, part.name);
+            break;
+        case RequireExpressionPart::Kind::Global:
+            info = info ? std::nullopt : resolveGlobal(context, part.name);
+            break;
+        case RequireExpressionPart::Kind::IndexName:
+            info = info ? resolveIndex(context, part.name, /* isIndexName: */ true) : std::nullopt;
+            break;
+        case RequireExpressionPart::Kind::IndexString:
+            info = info ? resolveIndex(context, part.name, /* isIndexName: */ false) : std::nullopt;
+            break;
+        case RequireExpressionPart::Kind::MethodCall:
+            info = info ? resolveMethodCall(context, part.name, part.argument, part.argumentCount) : std::nullopt;
+            break;
+        }
+
+        if (!info)
+            return std::nullopt;
+    }
+
+    return info;
+}
+
 std::string WorkspaceFileResolver::getHumanReadableModuleName(const Luau::ModuleName& name) const
 {
     if (isVirtualPath(name))
@@ -395,9 +459,49 @@ const Luau::Config& WorkspaceFileResolver::getConfig(const Luau::ModuleName& nam
     if (!realPath || !realPath->has_relative_path() || !realPath->has_parent_path())
         return defaultConfig;
 
+    // Package modules are only checked to produce types for their dependents, so we do not lint them
+    if (isPackageFile(*realPath))
+    {
+        auto key = realPath->parent_path().generic_string();
+        if (auto it = packageConfigCache.find(key); it != packageConfigCache.end())
+            return it->second;
+
+        Luau::Config result = readConfigRec(realPath->parent_path());
+        result.enabledLint = {};
+        result.fatalLint = {};
+        result.lintErrors = false;
+        return packageConfigCache[key] = result;
+    }
+
     return readConfigRec(realPath->parent_path());
 }
 
+bool WorkspaceFileResolver::isPackageFile(const std::filesystem::path& path) const
+{
+    if (!client)
+        return false;
+
+    auto key = path.generic_string();
+    if (auto it = packageFileCache.find(key); it != packageFileCache.end())
+        return it->second;
+
+    return packageFileCache[key] = isPackageFile(path, client->getConfiguration(rootUri));
+}
+
+bool WorkspaceFileResolver::isPackageFile(const std::filesystem::path& path, const ClientConfiguration& config) const
+{
+    if (config.packageGlobs.empty())
+        return false;
+
+    // We want to test globs against a relative path to workspace, since that's what makes most sense
+    auto relativePath = path.lexically_relative(rootUri.fsPath()).generic_string(); // HACK: we convert to generic string so we get '/' separators
+    for (auto& pattern : config.packageGlobs)
+        if (glob::fnmatch_case(relativePath, pattern))
+            return true;
+
+    return false;
+}
+
 const Luau::Config& WorkspaceFileResolver::readConfigRec(const std::filesystem::path& path) const
 {
     auto it = configCache.find(path.generic_string());
@@ -439,6 +543,8 @@ const Luau::Config& WorkspaceFileResolver::readConfigRec(const std::filesystem::
 void WorkspaceFileResolver::clearConfigCache()
 {
     configCache.clear();
+    packageConfigCache.clear();
+    packageFileCache.clear();
 }
 
 void WorkspaceFileResolver::writePathsToMap(const SourceNodePtr& node, const std::string& base)
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Luau/Frontend.h"
+
+#include "LSP/WorkspaceFileResolver.hpp"
+
+/// The require graph of the files being analyzed, found by scanning each file for its requires without parsing it
+struct DependencyGraph
+{
+    std::unordered_map<Luau::ModuleName, std::vector<Luau::ModuleName>> dependencies;
+    std::unordered_map<Luau::ModuleName, size_t> dependentCounts;
+};
+
+DependencyGraph scanDependencyGraph(WorkspaceFileResolver& fileResolver, const std::vector<std::filesystem::path>& files);
+
+/// Orders the files so that each file comes after the modules it requires. Require cycles are broken arbitrarily
+std::vector<std::filesystem::path> orderByDependencies(const std::vector<std::filesystem::path>& files, const DependencyGraph& graph);
+
+/// Tracks which modules have been checked whilst streaming, releasing each module once all of its dependents have been checked
+class StreamingReleaser
+{
+public:
+    /// The files are those which will be analyzed, in order. A file is never released before it has been analyzed
+    StreamingReleaser(Luau::Frontend& frontend, const DependencyGraph& graph, const std::vector<std::filesystem::path>& files);
+
+    /// Records that the module has been checked, along with every module it (transitively) requires that was not already checked
+    void markChecked(const Luau::ModuleName& root);
+
+private:
+    Luau::Frontend& frontend;
+    const DependencyGraph& graph;
+    std::unordered_map<Luau::ModuleName, size_t> remainingDependents;
+    // Files which are yet to be analyzed. A file checked early as part of a require cycle is only recorded once it is analyzed
+    std::unordered_set<Luau::ModuleName> queued{};
+    std::unordered_set<Luau::ModuleName> checked{};
+    std::unordered_set<Luau::ModuleName> released{};
+
+    void releaseIfUnneeded(const Luau::ModuleName& name);
+};
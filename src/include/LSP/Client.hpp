@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <optional>
 #include "Luau/Documentation.h"
 #include "Protocol/Lifecycle.hpp"
@@ -32,6 +33,8 @@ public:
     std::vector<std::filesystem::path> definitionsFiles{};
     /// A registered documentation file passed by the client
     std::vector<std::filesystem::path> documentationFiles{};
+    /// A directory passed by the client where data can be persisted between sessions
+    std::optional<std::filesystem::path> cacheDirectory = std::nullopt;
     /// Parsed documentation database
     Luau::DocumentationDatabase documentation{""};
     /// Global configuration. These are the default settings that we will use if we don't have the workspace stored in configStore
@@ -82,6 +85,10 @@ public:
     void setTrace(const lsp::SetTraceParams& params);
 
     static bool readRawMessage(std::string& output);
+    /// Whether a message from the client is waiting to be read, without blocking
+    static bool hasPendingMessage();
+    /// Waits up to the timeout for a message from the client to be ready to read. Returns whether one is waiting
+    static bool waitForMessage(std::chrono::milliseconds timeout);
 
     void handleResponse(const JsonRpcMessage& message);
 
@@ -2,6 +2,16 @@
 #include <vector>
 #include "nlohmann/json.hpp"
 
+enum struct DependentsModeConfig
+{
+    OnChange,
+    OnSave,
+};
+NLOHMANN_JSON_SERIALIZE_ENUM(DependentsModeConfig, {
+                                                       {DependentsModeConfig::OnChange, "onChange"},
+                                                       {DependentsModeConfig::OnSave, "onSave"},
+                                                   })
+
 struct ClientDiagnosticsConfiguration
 {
     /// Whether to also compute diagnostics for dependents when a file changes
@@ -10,8 +20,18 @@ struct ClientDiagnosticsConfiguration
     bool workspace = false;
     /// Whether to use expressive DM types in the diagnostics typechecker
     bool strictDatamodelTypes = true;
+    /// The time (in milliseconds) that may be spent in a single background pass recomputing diagnostics for dependents
+    /// when using pull-based diagnostics
+    size_t dependentsTimeBudget = 50;
+    /// Whether to report syntax errors and lints before type checking when the dependencies of a file have not yet been checked.
+    /// Type errors are reported once checking has completed in the background
+    bool syntaxFirst = true;
+    /// When the diagnostics of the dependents of an edited document are recomputed. In `onSave` mode, only the edited document is
+    /// checked as it changes, and the diagnostics of its dependents are recomputed once it is saved
+    DependentsModeConfig dependentsMode = DependentsModeConfig::OnChange;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientDiagnosticsConfiguration, includeDependents, workspace, strictDatamodelTypes)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    ClientDiagnosticsConfiguration, includeDependents, workspace, strictDatamodelTypes, dependentsTimeBudget, syntaxFirst, dependentsMode)
 
 struct ClientSourcemapConfiguration
 {
@@ -182,6 +202,24 @@ struct ClientFFlagsConfiguration
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientFFlagsConfiguration, enableByDefault, sync, override);
 
+struct ClientMemoryConfiguration
+{
+    /// The memory budget of the server in megabytes. As memory usage approaches the budget, the caches held for closed files are released.
+    /// A value of 0 uses the memory limit of the container the server is running in, if any
+    size_t limit = 0;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientMemoryConfiguration, limit);
+
+struct ClientDebugConfiguration
+{
+    /// Requests which take longer than this many milliseconds have a breakdown of where their time was spent written to the log.
+    /// A value of 0 disables the breakdown
+    size_t slowRequestThreshold = 1000;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientDebugConfiguration, slowRequestThreshold);
+
 
 // These are the passed configuration options by the client, prefixed with `luau-lsp.`
 // Here we also define the default settings
@@ -191,6 +229,11 @@ struct ClientConfiguration
     /// DEPRECATED: Use completion.autocompleteEnd instead
     bool autocompleteEnd = false;
     std::vector<std::string> ignoreGlobs{};
+    /// Globs matching vendored package files (e.g. Wally packages). These modules are only checked as a dependency
+    /// of other modules, lints are not run on them, and their diagnostics are not reported
+    std::vector<std::string> packageGlobs{"**/_Index/**"};
+    /// Whether files and directories ignored by the workspace's `.gitignore` should be skipped when searching the workspace for files
+    bool respectGitignore = false;
     ClientSourcemapConfiguration sourcemap{};
     ClientDiagnosticsConfiguration diagnostics{};
     ClientTypesConfiguration types{};
@@ -201,6 +244,8 @@ struct ClientConfiguration
     ClientRequireConfiguration require{};
     ClientIndexConfiguration index{};
     ClientFFlagsConfiguration fflags{};
+    ClientMemoryConfiguration memory{};
+    ClientDebugConfiguration debug{};
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientConfiguration, autocompleteEnd, ignoreGlobs, sourcemap, diagnostics, types, inlayHints, hover,
-    completion, signatureHelp, require, index, fflags);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ClientConfiguration, autocompleteEnd, ignoreGlobs, packageGlobs, respectGitignore, sourcemap,
+    diagnostics, types, inlayHints, hover, completion, signatureHelp, require, index, fflags, memory, debug);
@@ -0,0 +1,61 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Protocol/Diagnostics.hpp"
+
+/// The hashes of the inputs which a module's diagnostics were computed from
+struct ModuleHashes
+{
+    std::string contentHash;
+    std::string dependencyHash;
+};
+
+/// Diagnostics of a module computed in a previous session, alongside the hashes of the inputs they were computed from
+struct CachedDiagnostics
+{
+    std::string contentHash;
+    std::string dependencyHash;
+    std::vector<lsp::Diagnostic> diagnostics{};
+};
+NLOHMANN_DEFINE_OPTIONAL(CachedDiagnostics, contentHash, dependencyHash, diagnostics)
+
+/// A persistent store of the last computed diagnostics for each module, used to show diagnostics immediately after the
+/// server restarts whilst the modules are type checked again in the background
+class DiagnosticsCache
+{
+private:
+    std::optional<std::filesystem::path> path = std::nullopt;
+
+    /// Hash of the state shared by all modules (e.g. configuration and definitions files).
+    /// If this does not match the current environment, the stored entries are discarded
+    std::string environmentHash;
+    std::unordered_map<std::string /* Luau::ModuleName */, CachedDiagnostics> entries{};
+
+    /// Diagnostics computed during this session. Their hashes are only computed when the cache is saved,
+    /// so that we do not need to hash the dependencies every time diagnostics are computed
+    std::unordered_map<std::string /* Luau::ModuleName */, std::vector<lsp::Diagnostic>> updated{};
+
+public:
+    bool isEnabled() const
+    {
+        return path.has_value();
+    }
+
+    /// Loads the cache from the given file. The cache is enabled even if the file does not exist yet
+    void load(const std::filesystem::path& cachePath);
+
+    /// Removes and returns the entry stored for the module, if it was computed in the given environment
+    std::optional<CachedDiagnostics> take(const std::string& moduleName, const std::string& currentEnvironmentHash);
+
+    /// Records the latest diagnostics computed for the module
+    void record(const std::string& moduleName, const std::vector<lsp::Diagnostic>& diagnostics);
+
+    /// Writes the cache to disk, computing the hashes for the diagnostics recorded this session.
+    /// If the hashes cannot be computed (e.g. the diagnostics are now out of date), then the module is not persisted
+    bool save(const std::string& currentEnvironmentHash, const std::function<std::optional<ModuleHashes>(const std::string&)>& computeHashes);
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// An in-memory tree of directories and the Luau source files within them, used to complete require paths without reading the
+/// filesystem on every keystroke. The contents of a directory are read from disk the first time it is listed, and are then kept
+/// current by file watcher events, and by the client's file operation events for folders
+class DirectoryInventory
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        bool isDirectory = false;
+
+        bool operator==(const Entry& other) const
+        {
+            return name == other.name && isDirectory == other.isDirectory;
+        }
+    };
+
+    /// Lists the subdirectories and source files of the directory, in name order, reading it from disk if it has not been listed before.
+    /// Returns std::nullopt if the directory cannot be read
+    std::optional<std::vector<Entry>> list(const std::filesystem::path& directory);
+    /// Reads the subdirectories and source files of the directory from disk, in name order, without keeping them.
+    /// Used for directories which are not covered by file watcher events. Returns std::nullopt if the directory cannot be read
+    static std::optional<std::vector<Entry>> read(const std::filesystem::path& directory);
+
+    /// Records that a source file or directory was created. Only directories which have already been listed are updated
+    void created(const std::filesystem::path& path, bool isDirectory);
+    /// Records that a source file or directory was deleted, forgetting everything within it
+    void deleted(const std::filesystem::path& path);
+    /// Forgets every listed directory, so that they are read from disk again
+    void clear();
+
+    /// The number of directories read from disk, used by tests to check that listings are reused
+    size_t directoryReadCount = 0;
+
+private:
+    struct Node
+    {
+        /// The name of the file or directory as it was found on disk
+        std::string name = "";
+        bool isDirectory = true;
+        /// Whether the contents of the directory have been read from disk
+        bool listed = false;
+        /// Keyed by the normalised name of each child
+        std::map<std::string, Node> children{};
+    };
+
+    Node root{};
+
+    /// Reads the contents of the directory from disk, keyed by normalised name. Returns std::nullopt if the directory cannot be read
+    static std::optional<std::map<std::string, Node>> readChildren(const std::filesystem::path& directory);
+    static std::vector<Entry> toEntries(const std::map<std::string, Node>& children);
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <regex>
+#include <string>
+#include <vector>
+
+/// A list of glob patterns which are compiled once, so that they can be cheaply tested against many paths
+class GlobSet
+{
+private:
+    std::vector<std::regex> patterns;
+
+public:
+    GlobSet() = default;
+    explicit GlobSet(const std::vector<std::string>& globs);
+
+    bool matches(const std::string& path) const;
+    bool empty() const
+    {
+        return patterns.empty();
+    }
+};
+
+/// Reads the `.gitignore` file at the root of the directory, and converts its rules into globs matching paths relative to the root.
+/// This is an approximation of gitignore semantics: only the root `.gitignore` file is read, and if any rule is negated (`!pattern`)
+/// then no rules are returned, as we cannot safely skip a directory which may have some of its contents re-included
+std::vector<std::string> readGitignoreGlobs(const std::filesystem::path& root);
+
+/// Rules for which parts of a directory tree should be skipped when searching for source files
+struct DirectoryWalkRules
+{
+    /// The directory which all globs are matched relative to
+    std::filesystem::path root;
+    /// Ignore globs. Directories which match these (with a trailing `/`) are skipped entirely, as every file within would also match
+    GlobSet ignoreGlobs;
+    /// Globs read from the `.gitignore` file. Any file or directory matching these is skipped
+    GlobSet gitignoreGlobs;
+    /// The directory containing the `.gitignore` file, which its globs are matched relative to. Defaults to the root if empty
+    std::filesystem::path gitignoreRoot{};
+};
+
+/// Recursively searches the directory for Luau source files (`.lua` and `.luau`), calling the callback for each file found.
+/// Directories matching the rules are pruned, and never descended into. The walk is stopped if the callback returns false
+void walkSourceFiles(
+    const std::filesystem::path& directory, const DirectoryWalkRules& rules, const std::function<bool(const std::filesystem::path&)>& callback);
@@ -0,0 +1,95 @@
+#pragma once
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Luau/FileResolver.h"
+#include "nlohmann/json.hpp"
+
+/// Why a module was marked for rechecking
+enum struct InvalidationCause
+{
+    /// A document was opened in the editor, so its contents may differ from the file on disk
+    DocumentOpened,
+    /// A document open in the editor was edited
+    DocumentChanged,
+    /// A document was closed, so its contents are read from disk again
+    DocumentClosed,
+    /// A file changed on disk (reported by the file watcher)
+    FileChanged,
+    /// A file was renamed or moved, changing how requires of it resolve
+    FileRenamed,
+    /// The sourcemap was reloaded, which discards every module
+    SourcemapChanged,
+    /// The workspace configuration was reloaded, which reloads the sourcemap
+    ConfigurationChanged,
+    /// The Studio plugin sent new DataModel information, which reloads the sourcemap
+    StudioPluginChanged,
+    /// A feature needed the full type graph of a module which was checked without retaining it, or whose graph was since released
+    TypeGraphNotRetained,
+    /// A feature needed the real source of a module which was checked using its interface from the previous session
+    InterfaceStubReleased,
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(InvalidationCause, {
+                                                    {InvalidationCause::DocumentOpened, "documentOpened"},
+                                                    {InvalidationCause::DocumentChanged, "documentChanged"},
+                                                    {InvalidationCause::DocumentClosed, "documentClosed"},
+                                                    {InvalidationCause::FileChanged, "fileChanged"},
+                                                    {InvalidationCause::FileRenamed, "fileRenamed"},
+                                                    {InvalidationCause::SourcemapChanged, "sourcemapChanged"},
+                                                    {InvalidationCause::ConfigurationChanged, "configurationChanged"},
+                                                    {InvalidationCause::StudioPluginChanged, "studioPluginChanged"},
+                                                    {InvalidationCause::TypeGraphNotRetained, "typeGraphNotRetained"},
+                                                    {InvalidationCause::InterfaceStubReleased, "interfaceStubReleased"},
+                                                })
+
+struct Invalidation
+{
+    /// Increases with each invalidation recorded, so that records of different modules can be ordered
+    size_t sequence = 0;
+    InvalidationCause cause = InvalidationCause::DocumentChanged;
+    /// The module whose change caused the invalidation, or empty if every module in the workspace was invalidated
+    Luau::ModuleName root = "";
+    /// The number of modules invalidated along with the root, i.e. its dependents
+    size_t moduleCount = 0;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Invalidation, sequence, cause, root, moduleCount);
+
+/// Records why each module was last marked for rechecking, so that needless invalidation can be tracked down in real sessions.
+/// Only the most recent records are kept for each module
+class InvalidationLog
+{
+public:
+    static constexpr size_t MAX_RECORDS_PER_MODULE = 8;
+    static constexpr size_t MAX_RECENT_INVALIDATIONS = 64;
+
+    /// Records that the modules were invalidated by a change to the root module. Does nothing if no modules were invalidated
+    void record(InvalidationCause cause, const Luau::ModuleName& root, const std::vector<Luau::ModuleName>& invalidated);
+    /// Records that every module in the workspace was invalidated
+    void recordWorkspace(InvalidationCause cause);
+
+    /// The invalidations which affected the module, oldest first, including those which invalidated the whole workspace
+    std::vector<Invalidation> forModule(const Luau::ModuleName& moduleName) const;
+    /// The invalidation which most recently affected the module
+    std::optional<Invalidation> latest(const Luau::ModuleName& moduleName) const;
+    /// The invalidations recorded across all modules, oldest first
+    const std::deque<Invalidation>& recent() const
+    {
+        return recentInvalidations;
+    }
+
+private:
+    size_t nextSequence = 1;
+    std::unordered_map<Luau::ModuleName, std::deque<Invalidation>> moduleInvalidations{};
+    std::deque<Invalidation> workspaceInvalidations{};
+    std::deque<Invalidation> recentInvalidations{};
+
+    Invalidation begin(InvalidationCause cause, const Luau::ModuleName& root, size_t moduleCount);
+};
+
+/// Describes the module being checked for a trace span, along with why it needed checking if known
+std::string describeCheckedModule(const InvalidationLog& log, const Luau::ModuleName& moduleName);
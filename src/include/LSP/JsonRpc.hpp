@@ -65,6 +65,9 @@ JsonRpcMessage parse(const std::string& jsonString);
 /// Reads a JSON-RPC message from input
 bool readRawMessage(std::istream& input, std::string& output);
 
+/// Whether input has already been read into the stream's buffer but not yet consumed, e.g. when the client sends several messages in one write
+bool hasBufferedInput(std::istream& input);
+
 /// Sends a raw JSON-RPC message to output stream
 void sendRawMessage(std::ostream& output, const json& message);
 
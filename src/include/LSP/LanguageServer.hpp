@@ -1,5 +1,6 @@
 #include <optional>
 #include <filesystem>
+#include <unordered_map>
 
 #include "nlohmann/json.hpp"
 
@@ -8,6 +9,10 @@
 
 #include "LSP/Client.hpp"
 #include "LSP/Workspace.hpp"
+#include "LSP/RequestTrace.hpp"
+#include "LSP/Profiler.hpp"
+#include "LSP/MemoryGovernor.hpp"
+#include "LSP/ResumableRequest.hpp"
 
 using json = nlohmann::json;
 using namespace json_rpc;
@@ -33,7 +38,7 @@ private:
 
 public:
     explicit LanguageServer(const std::vector<std::filesystem::path>& definitionsFiles, const std::vector<std::filesystem::path>& documentationFiles,
-        std::optional<Luau::Config> defaultConfig);
+        std::optional<Luau::Config> defaultConfig, std::optional<std::filesystem::path> cacheDirectory = std::nullopt);
 
     lsp::ServerCapabilities getServerCapabilities();
 
@@ -41,9 +46,12 @@ public:
     /// If no workspace is found, the file is attached to the null workspace
     WorkspaceFolderPtr findWorkspace(const lsp::DocumentUri& file);
 
-    void onRequest(const id_type& id, const std::string& method, std::optional<json> params);
+    void onRequest(const id_type& id, const std::string& method, std::optional<json> params,
+        tracing::Clock::duration queueTime = tracing::Clock::duration::zero());
     void onNotification(const std::string& method, std::optional<json> params);
     void processInputLoop();
+    /// Performs one pass of background work. Returns whether there is still pending work
+    bool processBackgroundWork();
     bool requestedShutdown();
 
     // Dispatch handlers
@@ -51,15 +59,21 @@ private:
     lsp::InitializeResult onInitialize(const lsp::InitializeParams& params);
     void onInitialized([[maybe_unused]] const lsp::InitializedParams& params);
 
-    void pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const size_t version);
+    void pushDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const size_t version, bool allowDeferredTypeCheck = false);
+    void pushDependentDiagnostics(WorkspaceFolderPtr& workspace, const lsp::DocumentUri& uri, const std::vector<Luau::ModuleName>& markedDirty,
+        lsp::DocumentDiagnosticReport& diagnostics);
     void recomputeDiagnostics(WorkspaceFolderPtr& workspace, const ClientConfiguration& config);
 
     void onDidOpenTextDocument(const lsp::DidOpenTextDocumentParams& params);
     void onDidChangeTextDocument(const lsp::DidChangeTextDocumentParams& params);
+    void onDidSaveTextDocument(const lsp::DidSaveTextDocumentParams& params);
     void onDidCloseTextDocument(const lsp::DidCloseTextDocumentParams& params);
     void onDidChangeConfiguration(const lsp::DidChangeConfigurationParams& params);
     void onDidChangeWorkspaceFolders(const lsp::DidChangeWorkspaceFoldersParams& params);
     void onDidChangeWatchedFiles(const lsp::DidChangeWatchedFilesParams& params);
+    void onDidRenameFiles(const lsp::RenameFilesParams& params);
+    void onDidCreateFiles(const lsp::CreateFilesParams& params);
+    void onDidDeleteFiles(const lsp::DeleteFilesParams& params);
 
     void onStudioPluginFullChange(const PluginNode& dataModel);
     void onStudioPluginClear();
@@ -74,16 +88,45 @@ private:
     std::optional<lsp::SignatureHelp> signatureHelp(const lsp::SignatureHelpParams& params);
     lsp::DefinitionResult gotoDefinition(const lsp::DefinitionParams& params);
     std::optional<lsp::Location> gotoTypeDefinition(const lsp::TypeDefinitionParams& params);
-    lsp::ReferenceResult references(const lsp::ReferenceParams& params);
+    Resumable<lsp::ReferenceResult> references(const lsp::ReferenceParams& params);
     std::optional<std::vector<lsp::DocumentSymbol>> documentSymbol(const lsp::DocumentSymbolParams& params);
     lsp::RenameResult rename(const lsp::RenameParams& params);
     lsp::InlayHintResult inlayHint(const lsp::InlayHintParams& params);
     std::optional<lsp::SemanticTokens> semanticTokens(const lsp::SemanticTokensParams& params);
     lsp::DocumentDiagnosticReport documentDiagnostic(const lsp::DocumentDiagnosticParams& params);
-    lsp::PartialResponse<lsp::WorkspaceDiagnosticReport> workspaceDiagnostic(const lsp::WorkspaceDiagnosticParams& params);
+    Resumable<lsp::PartialResponse<lsp::WorkspaceDiagnosticReport>> workspaceDiagnostic(const lsp::WorkspaceDiagnosticParams& params);
+    Resumable<std::vector<lsp::WorkspaceSymbol>> workspaceSymbol(const lsp::WorkspaceSymbolParams& params);
+    Response profile(const ProfileParams& params);
+    Response invalidations(const lsp::TextDocumentIdentifier& params);
     Response onShutdown([[maybe_unused]] const id_type& id);
 
+    void reportSlowRequest(tracing::RequestTrace& trace, const std::optional<json>& params);
+    void pollProfiler(bool force = false);
+    void enforceMemoryBudget();
+
+    template<typename Start, typename Complete>
+    void scheduleRequest(const id_type& id, tracing::RequestTrace trace, std::optional<json> params, Start start, Complete complete);
+    template<typename Start>
+    void scheduleRequest(const id_type& id, tracing::RequestTrace trace, std::optional<json> params, Start start);
+    void resumePendingRequest();
+    void cancelPendingRequests(lsp::ErrorCode code, const std::string& reason);
+
 private:
     bool isInitialized = false;
     bool shutdownRequested = false;
+
+    // Responses to recent read-only requests, keyed by the method and its serialized parameters.
+    // Messages are handled in order, so until another message modifies server state, a duplicate request
+    // (e.g. hover or semantic tokens fired by multiple views) can be answered with the previously computed response.
+    // Cleared whenever a notification or client response is received
+    std::unordered_map<std::string, Response> recentResponses{};
+
+    // Long-running requests (e.g. find all references and workspace symbols) which yield between each module they process,
+    // so that interactive requests received in the meantime are not blocked behind them
+    RequestScheduler requestScheduler;
+
+    Profiler profiler;
+
+    MemoryGovernor memoryGovernor;
+    tracing::Clock::time_point lastMemoryCheck{};
 };
@@ -1,4 +1,5 @@
 #pragma once
+#include <limits>
 #include <optional>
 #include "Luau/AstQuery.h"
 #include "Luau/Frontend.h"
@@ -24,8 +25,25 @@ NLOHMANN_DEFINE_OPTIONAL(DefinitionsFileMetadata, CREATABLE_INSTANCES, SERVICES)
 
 std::optional<DefinitionsFileMetadata> parseDefinitionsFileMetadata(const std::string& definitions);
 
+// Sourcemap children of globally defined classes (services and player containers).
+// These are only attached to the class type once a module being checked references the class, so that
+// updating the sourcemap scales with the services in use rather than the size of the DataModel
+struct DeferredInstanceChildren
+{
+    struct Entry
+    {
+        Luau::TypeId ty;
+        SourceNodePtr node;
+    };
+
+    // Class name -> the class type and the node holding its children, per set of globals
+    std::unordered_map<const Luau::GlobalTypes*, std::unordered_map<std::string, Entry>> pending{};
+    // Class types which have had children attached, which need clearing when the sourcemap is updated
+    std::unordered_map<const Luau::GlobalTypes*, std::vector<Luau::TypeId>> materialized{};
+};
+
 void registerInstanceTypes(Luau::Frontend& frontend, const Luau::GlobalTypes& globals, Luau::TypeArena& arena,
-    const WorkspaceFileResolver& fileResolver, bool expressiveTypes);
+    const WorkspaceFileResolver& fileResolver, DeferredInstanceChildren& deferredChildren, bool expressiveTypes);
 Luau::LoadDefinitionFileResult registerDefinitions(Luau::Frontend& frontend, Luau::GlobalTypes& globals, const std::string& definitions,
     bool typeCheckForAutocomplete = false, std::optional<DefinitionsFileMetadata> metadata = std::nullopt);
 
@@ -59,6 +77,45 @@ std::vector<Luau::Location> findTypeReferences(const Luau::SourceModule& source,
 
 std::optional<Luau::Location> getLocation(Luau::TypeId type);
 
+/// An index over the scopes of a type checked module, which answers `Luau::findScopeAtPosition` queries in logarithmic time
+/// rather than scanning every scope in the module for each query.
+/// The index holds onto the scopes, so should be rebuilt when the module is rechecked
+class ScopeIndex
+{
+public:
+    explicit ScopeIndex(const Luau::Module& module);
+
+    /// Finds the innermost scope containing the position, equivalent to `Luau::findScopeAtPosition`
+    Luau::ScopePtr findScopeAtPosition(Luau::Position pos) const;
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    /// The approximate memory held by the index, in bytes
+    size_t memoryUsage() const
+    {
+        return sizeof(ScopeIndex) + entries.capacity() * sizeof(Entry);
+    }
+
+private:
+    static constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
+
+    struct Entry
+    {
+        Luau::Location location;
+        Luau::ScopePtr scope;
+        // The innermost scope enclosing this one
+        size_t parent = NO_PARENT;
+    };
+
+    // Sorted by start position, with enclosing scopes ordered before the scopes they enclose
+    std::vector<Entry> entries{};
+    // The module scope, returned when no other scope contains the position
+    Luau::ScopePtr moduleScope = nullptr;
+};
+
 std::optional<Luau::Location> lookupTypeLocation(const Luau::Scope& deepScope, const Luau::Name& name);
 std::optional<Luau::Property> lookupProp(const Luau::TypeId& parentType, const Luau::Name& name);
 std::optional<Luau::ModuleName> lookupImportedModule(const Luau::Scope& deepScope, const Luau::Name& name);
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+/// The caches held by a workspace which can be released under memory pressure.
+/// Caches are released in the order they are declared, as later caches are more expensive to rebuild
+enum struct CacheKind
+{
+    /// Results computed for the client, such as previously reported diagnostics and scope indexes. Recomputed on the next request
+    Results,
+    /// Syntax trees of closed modules which do not retain a type graph. Reparsed when a feature next needs them
+    SyntaxTrees,
+    /// Type graphs of closed modules. Rechecked when a feature next needs them
+    TypeGraphs,
+};
+
+/// The approximate size of each of the caches, in bytes
+struct CacheUsage
+{
+    size_t results = 0;
+    size_t syntaxTrees = 0;
+    size_t typeGraphs = 0;
+
+    size_t total() const
+    {
+        return results + syntaxTrees + typeGraphs;
+    }
+
+    CacheUsage& operator+=(const CacheUsage& other)
+    {
+        results += other.results;
+        syntaxTrees += other.syntaxTrees;
+        typeGraphs += other.typeGraphs;
+        return *this;
+    }
+};
+
+/// Decides when the caches held by the server must be released to stay within a memory budget.
+/// The budget is either configured by the user, or the memory limit of the container the server is running in
+class MemoryGovernor
+{
+public:
+    /// Caches are released once the memory in use exceeds this fraction of the budget
+    static constexpr double PRESSURE_THRESHOLD = 0.85;
+    /// Caches are released until the memory in use is estimated to be below this fraction of the budget
+    static constexpr double RELEASE_TARGET = 0.7;
+
+    /// Sets the budget configured by the user, in bytes. If 0, the memory limit of the container is used instead
+    void setConfiguredBudget(size_t bytes);
+    /// The memory budget in bytes, or std::nullopt if the memory available to the server is unbounded
+    std::optional<size_t> getBudget();
+
+    /// Returns the number of bytes of caches which should be released, given the memory currently in use and the approximate size of
+    /// the caches. Returns 0 if the server is not under memory pressure
+    size_t bytesToRelease(size_t usedBytes, size_t cachedBytes);
+    /// Records the approximate size of the caches after they were released.
+    /// Releasing memory does not necessarily shrink the process, as the allocator holds onto it for reuse. To prevent thrashing,
+    /// caches are not released again until they have grown past this size
+    void recordRelease(size_t remainingCachedBytes);
+
+    /// Reads the memory limit of the cgroup mounted at the given root (cgroup v2, falling back to cgroup v1)
+    static std::optional<size_t> readCgroupLimit(const std::filesystem::path& cgroupRoot = "/sys/fs/cgroup");
+    /// The resident memory of the server process, or std::nullopt if it cannot be determined on this platform
+    static std::optional<size_t> readResidentMemory();
+
+private:
+    std::optional<size_t> configuredBudget = std::nullopt;
+    bool hasDetectedBudget = false;
+    std::optional<size_t> detectedBudget = std::nullopt;
+    std::optional<size_t> cachedBytesAfterRelease = std::nullopt;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Luau/Module.h"
+#include "Protocol/Base.hpp"
+
+/// The exported interface (return type and exported type aliases) of a module checked in a previous session,
+/// alongside the hashes of the inputs it was computed from
+struct CachedModuleInterface
+{
+    std::string contentHash;
+    /// Hash of the interfaces of the modules this module directly requires
+    std::string dependencyHash;
+    std::string interfaceHash;
+    /// Source declaring only the interface, which can be checked in place of the module. Unset if the interface cannot be written as source
+    std::optional<std::string> stub = std::nullopt;
+};
+NLOHMANN_DEFINE_OPTIONAL(CachedModuleInterface, contentHash, dependencyHash, interfaceHash, stub)
+
+/// A persistent store of module interfaces. A module's interface remains valid whilst its contents and the interfaces of its
+/// dependencies are unchanged, which lets us determine whether a module's dependencies have meaningfully changed without checking them,
+/// and lets a valid interface stand in for the module when checking its dependents
+class ModuleInterfaceCache
+{
+private:
+    std::optional<std::filesystem::path> path = std::nullopt;
+    std::string environmentHash;
+    std::unordered_map<std::string /* Luau::ModuleName */, CachedModuleInterface> entries{};
+
+public:
+    bool isEnabled() const
+    {
+        return path.has_value();
+    }
+
+    /// Loads the cache from the given file. The cache is enabled even if the file does not exist yet
+    void load(const std::filesystem::path& cachePath);
+
+    /// Finds the interface stored for the module, if it was computed in the given environment
+    const CachedModuleInterface* find(const std::string& moduleName, const std::string& currentEnvironmentHash) const;
+
+    /// Stores the interface for the module, replacing any previous entry
+    void store(const std::string& moduleName, CachedModuleInterface entry, const std::string& currentEnvironmentHash);
+
+    bool save();
+};
+
+/// Serializes the exported interface of a checked module into a list of declarations
+std::vector<std::string> serializeModuleInterface(const Luau::Module& module);
+
+std::string hashModuleInterface(const std::vector<std::string>& exports);
+
+/// Writes the exported interface of a checked module as source which declares the same exported types and returns a value of the same type.
+/// Returns std::nullopt if the interface contains types which cannot be written as source (e.g. cyclic or free types)
+std::optional<std::string> createInterfaceStub(const Luau::Module& module);
@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+struct ProfileParams
+{
+    /// The length of time to sample for, in seconds
+    double duration = 10.0;
+    /// The file to write the profile to
+    std::string path;
+    /// The number of samples taken per second of CPU time
+    size_t frequency = 100;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ProfileParams, duration, path, frequency);
+
+/// A sampling CPU profiler for the server, driven by SIGPROF. The call stack of the server is captured at a fixed frequency of
+/// CPU time, and then written out as folded stacks: one line per unique stack, with frames separated by semicolons and followed by
+/// the number of samples. This format is understood by most flamegraph tools (e.g. flamegraph.pl, inferno, speedscope).
+/// Sampling only takes place whilst the server is doing work, so an idle server produces no samples
+class Profiler
+{
+public:
+    /// Whether sampling is supported on this platform
+    static bool isSupported();
+
+    bool isRunning() const
+    {
+        return outputPath.has_value();
+    }
+
+    /// When the profile in progress is due to be written, or std::nullopt if no profile is in progress
+    std::optional<std::chrono::steady_clock::time_point> getDeadline() const
+    {
+        if (!isRunning())
+            return std::nullopt;
+        return deadline;
+    }
+
+    /// Starts sampling for the requested duration. A profile must not already be in progress
+    void start(const ProfileParams& params);
+
+    /// Stops sampling and writes the profile once the requested duration has elapsed, or immediately if forced.
+    /// Returns a summary of the written profile, or std::nullopt if the profile is still in progress
+    std::optional<std::string> poll(bool force = false);
+
+private:
+    std::optional<std::filesystem::path> outputPath = std::nullopt;
+    std::chrono::steady_clock::time_point deadline{};
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tracing
+{
+using Clock = std::chrono::steady_clock;
+
+struct Span
+{
+    std::string name;
+    std::string detail;
+    size_t depth = 0;
+    Clock::time_point start;
+    Clock::time_point end;
+};
+
+/// A breakdown of where time was spent whilst handling a single request.
+/// Spans are recorded for every request, so that the breakdown of a slow request is available after the fact
+class RequestTrace
+{
+public:
+    explicit RequestTrace(std::string method, Clock::duration queueTime = Clock::duration::zero());
+
+    void beginSpan(std::string name, std::string detail = "");
+    void endSpan();
+    /// Begins a span which lasts until the next step or span begins at the same depth, or the enclosing span ends.
+    /// Used for work which is only observable through callbacks, such as each module checked by `Frontend::check`
+    void step(std::string name, std::string detail = "");
+    /// Ends any open spans, returning the total time spent handling the request
+    Clock::duration finish();
+
+    /// Formats the breakdown as an indented list of spans, with the time spent in each span outside of its children.
+    /// Spans shorter than the minimum duration are omitted
+    std::string format(Clock::duration minimumDuration = std::chrono::milliseconds(1)) const;
+
+    const std::string& getMethod() const
+    {
+        return method;
+    }
+
+    Clock::duration getQueueTime() const
+    {
+        return queueTime;
+    }
+
+    const std::vector<Span>& getSpans() const
+    {
+        return spans;
+    }
+
+private:
+    void endStep(Clock::time_point now);
+
+    std::string method;
+    Clock::duration queueTime;
+    Clock::time_point start;
+    std::optional<Clock::time_point> end = std::nullopt;
+    std::vector<Span> spans{};
+    std::vector<size_t> openSpans{};
+    std::optional<size_t> openStep = std::nullopt;
+};
+
+/// The trace of the request currently being handled, or nullptr if no request is being handled
+RequestTrace* currentTrace();
+
+/// Makes the trace current for the lifetime of this object
+class ScopedRequestTrace
+{
+public:
+    explicit ScopedRequestTrace(RequestTrace& trace);
+    ~ScopedRequestTrace();
+
+    ScopedRequestTrace(const ScopedRequestTrace&) = delete;
+    ScopedRequestTrace& operator=(const ScopedRequestTrace&) = delete;
+
+private:
+    RequestTrace* previous;
+};
+
+/// Records a span in the current trace for the lifetime of this object. Does nothing if no request is being handled
+class ScopedSpan
+{
+public:
+    explicit ScopedSpan(std::string name, std::string detail = "");
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    RequestTrace* trace;
+};
+
+/// Records a step in the current trace. Does nothing if no request is being handled
+void step(std::string name, std::string detail = "");
+} // namespace tracing
@@ -0,0 +1,48 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Luau/Location.h"
+
+/// A part of an expression passed to `require`. Each part after the first is resolved relative to the result of the previous part
+struct RequireExpressionPart
+{
+    enum struct Kind
+    {
+        /// A string literal, e.g. `require("./Module")`
+        String,
+        /// A global, e.g. `script` or `game`
+        Global,
+        /// An index by name, e.g. `.Parent`
+        IndexName,
+        /// An index by a string literal, e.g. `["Module"]`
+        IndexString,
+        /// A method call whose first argument is a string literal, e.g. `:WaitForChild("Module")`
+        MethodCall,
+    };
+
+    Kind kind = Kind::String;
+    /// The string literal, global name, index or method name
+    std::string name;
+    /// The first argument of a method call
+    std::string argument = "";
+    size_t argumentCount = 0;
+
+    bool operator==(const RequireExpressionPart& other) const
+    {
+        return kind == other.kind && name == other.name && argument == other.argument && argumentCount == other.argumentCount;
+    }
+};
+
+struct ScannedRequire
+{
+    std::vector<RequireExpressionPart> expression;
+    /// The location of the whole `require` call
+    Luau::Location location;
+};
+
+/// Finds the `require` calls in the source from its tokens alone, without building a syntax tree.
+/// Locals initialised to a supported expression (e.g. `local ReplicatedStorage = game:GetService("ReplicatedStorage")`) are substituted
+/// into the requires which use them. Requires whose argument is any other kind of expression are skipped
+std::vector<ScannedRequire> scanRequires(std::string_view source);
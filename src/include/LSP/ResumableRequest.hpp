@@ -0,0 +1,142 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "LSP/JsonRpc.hpp"
+
+/// A request handler split into units of work (e.g. one module at a time). Each call performs the next unit of work,
+/// returning the result once the handler is complete. Between calls, the server is free to handle other messages
+template<typename Result>
+using Resumable = std::function<std::optional<Result>()>;
+
+/// Performs every remaining unit of work, for callers which need the result immediately
+template<typename Result>
+Result runToCompletion(const Resumable<Result>& resumable)
+{
+    while (true)
+    {
+        if (auto result = resumable())
+            return std::move(*result);
+    }
+}
+
+/// A resumable whose result is already known
+template<typename Result>
+Resumable<Result> ready(Result result)
+{
+    return [result = std::move(result)]() -> std::optional<Result>
+    {
+        return result;
+    };
+}
+
+/// Visits one item per unit of work, accumulating into the state. Once every item is visited, finish produces the result from the state
+template<typename Result, typename Item, typename State, typename Visit, typename Finish>
+Resumable<Result> forEach(std::vector<Item> items, State initialState, Visit visit, Finish finish)
+{
+    struct Progress
+    {
+        std::vector<Item> items;
+        size_t next = 0;
+        State state;
+    };
+
+    auto progress = std::make_shared<Progress>(Progress{std::move(items), 0, std::move(initialState)});
+    return [progress, visit = std::move(visit), finish = std::move(finish)]() -> std::optional<Result>
+    {
+        if (progress->next < progress->items.size())
+        {
+            visit(progress->items[progress->next], progress->state);
+            progress->next += 1;
+            if (progress->next < progress->items.size())
+                return std::nullopt;
+        }
+
+        return finish(std::move(progress->state));
+    };
+}
+
+/// Transforms the result of the resumable once it is complete
+template<typename Result, typename Source, typename Transform>
+Resumable<Result> mapResult(Resumable<Source> resumable, Transform transform)
+{
+    return [resumable = std::move(resumable), transform = std::move(transform)]() -> std::optional<Result>
+    {
+        if (auto result = resumable())
+            return transform(std::move(*result));
+        return std::nullopt;
+    };
+}
+
+/// Runs each resumable in turn, combining each of their results into the final result
+template<typename Result, typename Part, typename Combine>
+Resumable<Result> sequence(std::vector<Resumable<Part>> parts, Result initialResult, Combine combine)
+{
+    struct Progress
+    {
+        std::vector<Resumable<Part>> parts;
+        size_t next = 0;
+        Result result;
+    };
+
+    auto progress = std::make_shared<Progress>(Progress{std::move(parts), 0, std::move(initialResult)});
+    return [progress, combine = std::move(combine)]() -> std::optional<Result>
+    {
+        if (progress->next < progress->parts.size())
+        {
+            auto part = progress->parts[progress->next]();
+            if (!part)
+                return std::nullopt;
+
+            combine(progress->result, std::move(*part));
+            progress->next += 1;
+            if (progress->next < progress->parts.size())
+                return std::nullopt;
+        }
+
+        return std::move(progress->result);
+    };
+}
+
+/// Interleaves the units of work of pending requests on the message thread, resuming each request in turn.
+/// Interactive requests received in between are handled as soon as the current unit of work is complete
+class RequestScheduler
+{
+public:
+    /// Performs the next unit of work of a request, returning true once the request is complete (and its response sent)
+    using ResumeFunction = std::function<bool()>;
+    /// Starts the request from scratch, returning the function which performs each of its units of work
+    using StartFunction = std::function<ResumeFunction()>;
+
+    /// Queues the request. It is started when it is first resumed
+    void schedule(const json_rpc::id_type& id, StartFunction start);
+
+    bool empty() const;
+    /// The id of the request which will be resumed next
+    const json_rpc::id_type& nextId() const;
+
+    /// Resumes the next pending request for one unit of work. The request is removed once it is complete, or if it throws
+    void resumeNext();
+
+    /// Removes the pending request, returning whether it was pending
+    bool cancel(const json_rpc::id_type& id);
+    /// Removes every pending request, returning their ids
+    std::vector<json_rpc::id_type> cancelAll();
+    /// Discards the progress of every pending request, so that each is started from scratch when it is next resumed.
+    /// Used when server state is modified, as the state accumulated so far (e.g. types found in a module) may no longer be valid
+    void restartAll();
+
+private:
+    struct PendingRequest
+    {
+        json_rpc::id_type id;
+        StartFunction start;
+        // Empty until the request is started
+        ResumeFunction resume = nullptr;
+    };
+
+    std::deque<PendingRequest> pending{};
+};
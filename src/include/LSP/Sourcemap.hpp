@@ -22,6 +22,9 @@ struct SourceNode
     // The corresponding TypeId for this sourcemap node
     // A different TypeId is created for each type checker (frontend.typeChecker and frontend.typeCheckerForAutocomplete)
     std::unordered_map<Luau::GlobalTypes const*, Luau::TypeId> tys{}; // NB: NOT POPULATED BY SOURCEMAP, created manually. Can be null!
+    // Canonical TypeIds shared between all children of this node which have no children of their own, keyed by class name.
+    // Such leaf children have an identical type, so we only create it once per type checker
+    std::unordered_map<Luau::GlobalTypes const*, std::unordered_map<std::string, Luau::TypeId>> leafTys{}; // NB: NOT POPULATED BY SOURCEMAP
 
     bool isScript();
     std::optional<std::filesystem::path> getScriptFilePath();
@@ -15,6 +15,8 @@ private:
     std::string _content;
     mutable std::optional<std::vector<size_t>> _lineOffsets = std::nullopt;
 
+    bool applyBatchedChanges(const std::vector<lsp::TextDocumentContentChangeEvent>& changes);
+
 public:
     TextDocument(lsp::DocumentUri uri, std::string languageId, size_t version, std::string content)
         : _uri(std::move(uri))
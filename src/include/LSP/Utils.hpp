@@ -5,6 +5,7 @@
 #include <sstream>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <algorithm>
 
@@ -23,6 +24,8 @@ std::string_view getFirstLine(const std::string_view& str);
 bool endsWith(const std::string_view& str, const std::string_view& suffix);
 bool replace(std::string& str, const std::string& from, const std::string& to);
 void replaceAll(std::string& str, const std::string& from, const std::string& to);
+/// Computes a hash of the string which is stable between sessions, so that it can be persisted to disk
+std::string hashString(const std::string_view& str);
 
 template<typename V>
 inline bool contains(const std::vector<V>& vec, const V& value)
@@ -41,3 +44,9 @@ inline bool contains(const std::map<K, V>& map, const K& value)
 {
     return map.find(value) != map.end();
 }
+
+template<class K>
+inline bool contains(const std::unordered_set<K>& set, const K& value)
+{
+    return set.find(value) != set.end();
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <iostream>
+#include <chrono>
 #include "Luau/Frontend.h"
+#include "Luau/Autocomplete.h"
 #include "Protocol/Structures.hpp"
 #include "Protocol/LanguageFeatures.hpp"
 #include "Protocol/SignatureHelp.hpp"
@@ -8,6 +10,14 @@
 #include "LSP/Client.hpp"
 #include "LSP/WorkspaceFileResolver.hpp"
 #include "LSP/LuauExt.hpp"
+#include "LSP/DirectoryWalker.hpp"
+#include "LSP/DiagnosticsCache.hpp"
+#include "LSP/ModuleInterfaceCache.hpp"
+#include "LSP/RequestTrace.hpp"
+#include "LSP/MemoryGovernor.hpp"
+#include "LSP/ResumableRequest.hpp"
+#include "LSP/InvalidationLog.hpp"
+#include "LSP/DirectoryInventory.hpp"
 
 struct Reference
 {
@@ -20,6 +30,30 @@ struct Reference
     }
 };
 
+/// Counts of the expensive operations performed by a workspace. These are not used by the server itself, but allow tests
+/// to assert upper bounds on the work done by a scenario, to catch regressions where a feature silently rechecks the world
+struct OperationCounts
+{
+    /// Calls to `Frontend::check`
+    size_t checks = 0;
+    /// Modules type checked by the frontend. A call to `Frontend::check` only type checks dirty modules
+    size_t modulesChecked = 0;
+    /// Modules parsed by the frontend. A call to `Frontend::parse` only parses dirty modules
+    size_t parses = 0;
+    /// Calls to `WorkspaceFileResolver::readSource`
+    size_t sourceReads = 0;
+    /// Sourcemap rebuilds
+    size_t sourcemapUpdates = 0;
+    /// Builds of the lookup tables used for completion items
+    size_t completionTableBuilds = 0;
+
+    OperationCounts operator-(const OperationCounts& other) const
+    {
+        return OperationCounts{checks - other.checks, modulesChecked - other.modulesChecked, parses - other.parses,
+            sourceReads - other.sourceReads, sourcemapUpdates - other.sourcemapUpdates, completionTableBuilds - other.completionTableBuilds};
+    }
+};
+
 class WorkspaceFolder
 {
 public:
@@ -30,7 +64,108 @@ public:
     Luau::Frontend frontend;
     bool isConfigured = false;
     Luau::TypeArena instanceTypes;
+    types::DeferredInstanceChildren deferredInstanceChildren;
     std::optional<types::DefinitionsFileMetadata> definitionsFileMetadata;
+    // Why each module was last marked for rechecking, for debugging needless invalidation
+    InvalidationLog invalidationLog;
+    // The directories listed when completing string requires, kept current by file watcher events
+    DirectoryInventory directoryInventory;
+
+private:
+    // Dependents of edited modules which still need their diagnostics recomputing (pull-based diagnostics only).
+    // Maps the module name to its distance in the require graph from the module that was changed
+    std::unordered_map<Luau::ModuleName, size_t> pendingDependentDiagnostics{};
+    // Whether a processed dependent needs the client to pull diagnostics again, once every pending dependent has been processed
+    bool refreshAfterDependentDiagnostics = false;
+    // Modules edited since they were last saved, mapped to the dependents marked dirty by those edits.
+    // The diagnostics of the dependents are not recomputed until the module is saved
+    std::unordered_map<Luau::ModuleName, std::vector<Luau::ModuleName>> unsavedDependents{};
+
+    // Diagnostics persisted between sessions, so that they can be shown before the first type check completes
+    DiagnosticsCache diagnosticsCache;
+    // Interfaces of the modules checked in the previous session, used to tell whether a module's dependencies have changed
+    // and checked in place of unchanged dependencies
+    ModuleInterfaceCache moduleInterfaceCache;
+
+    struct InterfaceStub
+    {
+        // The modules required by the real source of the module. The stub is released when any of them are invalidated
+        std::unordered_set<Luau::ModuleName> requireSet;
+        std::string interfaceHash;
+    };
+    // Modules whose interface from the previous session is checked in place of their real source (see `applyInterfaceStubs`)
+    std::unordered_map<Luau::ModuleName, InterfaceStub> interfaceStubs{};
+    // Combined hash of the loaded definitions files, as part of the environment the cached diagnostics were computed in
+    std::string definitionsHash;
+
+    struct DeferredTypeCheck
+    {
+        lsp::DocumentUri uri;
+        std::vector<lsp::Diagnostic> servedDiagnostics;
+    };
+    // Documents which were served diagnostics without being type checked (either from the cache, or only syntax errors and lints),
+    // and still need to be type checked in the background
+    std::vector<DeferredTypeCheck> pendingDeferredTypeChecks{};
+    // The type errors last reported for each module, which are carried over into syntax-only diagnostics to prevent flickering.
+    // Errors within or after an edited region are dropped, as their positions are no longer known
+    std::unordered_map<Luau::ModuleName, std::vector<lsp::Diagnostic>> lastTypeErrorDiagnostics{};
+
+    struct ReportedDiagnostics
+    {
+        std::string resultId;
+        std::vector<lsp::Diagnostic> items;
+    };
+    // The diagnostics last reported to the client for each document in the pull-based model, keyed by their result id
+    std::unordered_map<std::string /* lsp::DocumentUri */, ReportedDiagnostics> reportedDiagnostics{};
+    // The documents last given a non-empty report by workspace diagnostics, which must be cleared if they are no longer walked
+    std::unordered_set<std::string /* lsp::DocumentUri */> workspaceReportedUris{};
+    size_t nextDiagnosticsResultId = 0;
+
+    // Whether modules have been checked for diagnostics since their type graphs were last compacted
+    bool hasUncompactedTypeGraphs = false;
+
+    size_t checkCount = 0;
+    size_t sourcemapUpdateCount = 0;
+    size_t completionTableBuildCount = 0;
+
+    struct CachedScopeIndex
+    {
+        std::weak_ptr<Luau::Module> module;
+        std::shared_ptr<const ScopeIndex> index;
+    };
+    // Scope indexes of modules queried by cursor-based features, keyed by the module they were built from.
+    // A module is replaced when it is rechecked, so an index remains valid for as long as its module is alive
+    std::unordered_map<const Luau::Module*, CachedScopeIndex> scopeIndexes{};
+
+    // The autocomplete type checker's global environment is built once startup diagnostics are complete (or sooner, if a feature needs it),
+    // so that loading it does not delay the first diagnostics. Until then, we hold onto the definitions to load into it
+    bool hasAutocompleteGlobals = false;
+    std::vector<std::pair<std::string, std::optional<types::DefinitionsFileMetadata>>> pendingAutocompleteDefinitions{};
+
+    // Lookup tables used to build completion items, which only depend on the global environment and definitions metadata.
+    // These are built on first use, and discarded whenever the globals change (e.g. when instance types are registered)
+    struct CompletionTables
+    {
+        // Entries for the completion callbacks of Roblox APIs which only accept a class, enum, creatable instance or service name
+        std::optional<Luau::AutocompleteEntryMap> instanceClassNames = std::nullopt;
+        std::optional<Luau::AutocompleteEntryMap> enumNames = std::nullopt;
+        Luau::AutocompleteEntryMap creatableInstances{};
+        Luau::AutocompleteEntryMap services{};
+
+        std::unordered_set<std::string> commonServices{};
+        std::unordered_set<std::string> commonInstanceProperties{};
+        std::unordered_set<std::string> commonServiceProviderProperties{};
+
+        const Luau::ClassType* serviceProviderClass = nullptr;
+        const Luau::ClassType* instanceClass = nullptr;
+        // The properties to prioritise when indexing each class seen so far, or nullptr if none are prioritised.
+        // Classes are only ever added to the globals, so whether a class derives from Instance or ServiceProvider never changes
+        std::unordered_map<const Luau::ClassType*, const std::unordered_set<std::string>*> prioritisedPropertiesByClass{};
+
+        /// The common properties to prioritise when indexing an Instance or ServiceProvider, or nullptr for any other class
+        const std::unordered_set<std::string>* prioritisedProperties(const Luau::ClassType* containingClass);
+    };
+    std::optional<CompletionTables> completionTables = std::nullopt;
 
 public:
     WorkspaceFolder(const std::shared_ptr<Client>& client, std::string name, const lsp::DocumentUri& uri, std::optional<Luau::Config> defaultConfig)
@@ -57,36 +192,105 @@ public:
     void openTextDocument(const lsp::DocumentUri& uri, const lsp::DidOpenTextDocumentParams& params);
     void updateTextDocument(
         const lsp::DocumentUri& uri, const lsp::DidChangeTextDocumentParams& params, std::vector<Luau::ModuleName>* markedDirty = nullptr);
+    /// Collects the dependents whose diagnostics were deferred whilst the document was edited, as dependents are rechecked on save
+    void saveTextDocument(const lsp::DocumentUri& uri, std::vector<Luau::ModuleName>* deferredDependents = nullptr);
     void closeTextDocument(const lsp::DocumentUri& uri);
+    /// Remaps the modules of a renamed or moved file (or every file within a renamed folder) to their new module names, keeping their parsed
+    /// and checked state. Only modules whose requires resolve differently after the rename are invalidated.
+    /// Returns the number of modules remapped
+    size_t renameFile(const lsp::DocumentUri& oldUri, const lsp::DocumentUri& newUri, std::vector<Luau::ModuleName>* markedDirty = nullptr);
 
     /// Whether the file has been marked as ignored by any of the ignored lists in the configuration
     bool isIgnoredFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig = std::nullopt);
     /// Whether the file has been specified in the configuration as a definitions file
     bool isDefinitionFile(const std::filesystem::path& path, const std::optional<ClientConfiguration>& givenConfig = std::nullopt);
+    /// The rules used to prune ignored directories when searching the workspace for source files
+    DirectoryWalkRules getDirectoryWalkRules(const ClientConfiguration& config);
 
-    lsp::DocumentDiagnosticReport documentDiagnostics(const lsp::DocumentDiagnosticParams& params);
+    /// Computes the diagnostics for a document. If allowDeferredTypeCheck is set and the document cannot be checked quickly,
+    /// then diagnostics not requiring a type check are returned and the document is checked in the background
+    lsp::DocumentDiagnosticReport documentDiagnostics(const lsp::DocumentDiagnosticParams& params, bool allowDeferredTypeCheck = false);
+    /// Assigns a result id to the report. If the client already holds the same diagnostics, the report is marked as unchanged
+    void applyDiagnosticsResultId(const lsp::DocumentDiagnosticParams& params, lsp::DocumentDiagnosticReport& report);
     lsp::WorkspaceDiagnosticReport workspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params);
+    Resumable<lsp::WorkspaceDiagnosticReport> resumableWorkspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params);
+
+    /// Queues the dependents of a changed module so that their diagnostics can be recomputed in the background
+    void queueDependentDiagnostics(const Luau::ModuleName& changedModule, const std::vector<Luau::ModuleName>& markedDirty);
+    /// Recomputes diagnostics for queued dependents until the time budget is exhausted.
+    /// Returns whether there is still pending work
+    bool processDependentDiagnostics(std::chrono::milliseconds budget);
+
+    /// Type checks the next document which was served diagnostics without a type check, updating the client if they have changed.
+    /// Returns whether a document was checked
+    bool processDeferredTypeCheck();
+    /// Builds the autocomplete type checker's global environment if it has not been built yet.
+    /// Returns whether it was built by this call
+    bool ensureAutocompleteGlobals();
+    /// Persists the diagnostics and module interfaces computed in this session to the cache directory
+    void saveCaches();
 
     void clearDiagnosticsForFile(const lsp::DocumentUri& uri);
 
+    /// Marks the module and its dependents for rechecking, recording the cause against each module invalidated
+    void markDirty(const Luau::ModuleName& moduleName, InvalidationCause cause, std::vector<Luau::ModuleName>* markedDirty = nullptr);
+
     void indexFiles(const ClientConfiguration& config);
 
     Luau::CheckResult checkSimple(const Luau::ModuleName& moduleName, bool runLintChecks = false);
     void checkStrict(const Luau::ModuleName& moduleName, bool forAutocomplete = true);
+    /// Releases the type graphs retained by the diagnostics type checker which are no longer needed.
+    /// Returns the number of modules compacted
+    size_t compactTypeGraphs();
+    /// Estimates the memory held by each of the caches which can be released under memory pressure
+    CacheUsage estimateCacheUsage();
+    /// Releases the cache for closed modules, returning the approximate number of bytes released
+    size_t releaseCache(CacheKind kind);
+    /// Finds the syntax tree of the module, reparsing it if it was released under memory pressure
+    Luau::SourceModule* getSourceModule(const Luau::ModuleName& moduleName);
+
+    OperationCounts getOperationCounts() const;
+
+    /// Returns an index for finding the scope at a position in the module, reusing the index built by a previous query if possible
+    std::shared_ptr<const ScopeIndex> getScopeIndex(const Luau::ModulePtr& module);
 
 private:
     void endAutocompletion(const lsp::CompletionParams& params);
+    CompletionTables& getCompletionTables();
     void suggestImports(const Luau::ModuleName& moduleName, const Luau::Position& position, const ClientConfiguration& config,
         const TextDocument& textDocument, std::vector<lsp::CompletionItem>& result, bool includeServices = true);
     lsp::WorkspaceEdit computeOrganiseRequiresEdit(const lsp::DocumentUri& uri);
     lsp::WorkspaceEdit computeOrganiseServicesEdit(const lsp::DocumentUri& uri);
     std::vector<Luau::ModuleName> findReverseDependencies(const Luau::ModuleName& moduleName);
+    void traceModuleChecks();
+    void indexModule(const Luau::ModuleName& moduleName);
+    bool renameModule(
+        const Luau::ModuleName& oldName, const Luau::ModuleName& newName, bool keepSyntaxTree, std::vector<Luau::ModuleName>* markedDirty);
+    std::optional<lsp::WorkspaceDocumentDiagnosticReport> computeDocumentReport(const Uri& uri, const ClientConfiguration& config);
+    lsp::WorkspaceDocumentDiagnosticReport clearingDocumentReport(const Uri& uri);
+    std::string getCacheEnvironmentHash(const ClientConfiguration& config);
+    std::optional<std::string> getInterfaceHash(const Luau::ModuleName& moduleName, const std::string& environmentHash,
+        std::unordered_map<Luau::ModuleName, std::optional<std::string>>& visited);
+    std::optional<std::string> computeDependencyHash(const Luau::ModuleName& moduleName, const std::string& environmentHash,
+        std::unordered_map<Luau::ModuleName, std::optional<std::string>>& visited);
+    std::optional<ModuleHashes> computeModuleHashes(const Luau::ModuleName& moduleName, const std::string& environmentHash,
+        std::unordered_map<Luau::ModuleName, std::optional<std::string>>& visited);
+    std::optional<std::vector<lsp::Diagnostic>> takeWarmStartDiagnostics(const Luau::ModuleName& moduleName, const ClientConfiguration& config);
+    void applyInterfaceStubs(const Luau::ModuleName& moduleName, const ClientConfiguration& config);
+    std::vector<Luau::ModuleName> releaseInterfaceStub(const Luau::ModuleName& moduleName);
+    void releaseInvalidatedInterfaceStubs(std::vector<Luau::ModuleName>& invalidated);
+    void releaseInterfaceStubs();
+    std::optional<std::vector<lsp::Diagnostic>> computeSyntaxDiagnostics(
+        const Luau::ModuleName& moduleName, const TextDocument* textDocument, const ClientConfiguration& config);
+    void deferTypeCheck(const lsp::DocumentUri& uri, const std::vector<lsp::Diagnostic>& servedDiagnostics);
 
 public:
     std::vector<std::string> getComments(const Luau::ModuleName& moduleName, const Luau::Location& node);
     std::optional<std::string> getDocumentationForType(const Luau::TypeId ty);
     std::vector<Reference> findAllReferences(const Luau::TypeId ty, std::optional<Luau::Name> property = std::nullopt);
+    Resumable<std::vector<Reference>> resumableFindAllReferences(Luau::TypeId ty, std::optional<Luau::Name> property = std::nullopt);
     std::vector<Reference> findAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName);
+    Resumable<std::vector<Reference>> resumableFindAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName);
 
     std::vector<lsp::CompletionItem> completion(const lsp::CompletionParams& params);
 
@@ -104,19 +308,22 @@ public:
     std::optional<lsp::Location> gotoTypeDefinition(const lsp::TypeDefinitionParams& params);
 
     lsp::ReferenceResult references(const lsp::ReferenceParams& params);
+    Resumable<lsp::ReferenceResult> resumableReferences(const lsp::ReferenceParams& params);
     lsp::RenameResult rename(const lsp::RenameParams& params);
     lsp::InlayHintResult inlayHint(const lsp::InlayHintParams& params);
     std::vector<lsp::FoldingRange> foldingRange(const lsp::FoldingRangeParams& params);
 
     std::vector<lsp::CallHierarchyItem> prepareCallHierarchy(const lsp::CallHierarchyPrepareParams& params);
     std::vector<lsp::CallHierarchyIncomingCall> callHierarchyIncomingCalls(const lsp::CallHierarchyIncomingCallsParams& params);
+    Resumable<std::vector<lsp::CallHierarchyIncomingCall>> resumableCallHierarchyIncomingCalls(const lsp::CallHierarchyIncomingCallsParams& params);
     std::vector<lsp::CallHierarchyOutgoingCall> callHierarchyOutgoingCalls(const lsp::CallHierarchyOutgoingCallsParams& params);
 
     std::optional<std::vector<lsp::DocumentSymbol>> documentSymbol(const lsp::DocumentSymbolParams& params);
     std::optional<std::vector<lsp::WorkspaceSymbol>> workspaceSymbol(const lsp::WorkspaceSymbolParams& params);
+    Resumable<std::vector<lsp::WorkspaceSymbol>> resumableWorkspaceSymbol(const lsp::WorkspaceSymbolParams& params);
     std::optional<lsp::SemanticTokens> semanticTokens(const lsp::SemanticTokensParams& params);
 
-    bool updateSourceMap();
+    bool updateSourceMap(InvalidationCause cause);
 
     bool isNullWorkspace() const
     {
@@ -9,6 +9,7 @@
 #include "LSP/Client.hpp"
 #include "LSP/Uri.hpp"
 #include "LSP/Sourcemap.hpp"
+#include "LSP/RequireScanner.hpp"
 #include "LSP/TextDocument.hpp"
 
 
@@ -90,6 +91,15 @@ struct WorkspaceFileResolver
     // Currently opened files where content is managed by client
     mutable std::unordered_map</* DocumentUri */ std::string, TextDocument> managedFiles{};
     mutable std::unordered_map<std::string, Luau::Config> configCache{};
+    // Configurations for package modules, which have linting disabled
+    mutable std::unordered_map<std::string, Luau::Config> packageConfigCache{};
+    // Whether each file is a package file, as matching the package globs requires the configuration
+    mutable std::unordered_map<std::string, bool> packageFileCache{};
+
+    // The number of calls to readSource, used by tests to check that sources are not needlessly reread
+    size_t sourceReadCount = 0;
+    // Sources read in place of the real contents of modules, which declare only their interface as checked in a previous session
+    std::unordered_map<Luau::ModuleName, std::string> interfaceStubs{};
 
     WorkspaceFileResolver()
     {
@@ -135,12 +145,22 @@ struct WorkspaceFileResolver
     std::optional<Luau::SourceCode> readSource(const Luau::ModuleName& name) override;
 
     std::optional<Luau::ModuleInfo> resolveStringRequire(const Luau::ModuleInfo* context, const std::string& requiredString) const;
+    std::optional<Luau::ModuleInfo> resolveGlobal(const Luau::ModuleInfo* context, const std::string& name) const;
     std::optional<Luau::ModuleInfo> resolveModule(const Luau::ModuleInfo* context, Luau::AstExpr* node) override;
+    /// Resolves a require expression found by the RequireScanner, in the same way that resolveModule resolves each part of the expression
+    std::optional<Luau::ModuleInfo> resolveRequireExpression(
+        const Luau::ModuleName& currentModule, const std::vector<RequireExpressionPart>& expression) const;
 
     std::string getHumanReadableModuleName(const Luau::ModuleName& name) const override;
 
     const Luau::Config& getConfig(const Luau::ModuleName& name) const override;
 
+    /// Whether the file matches any of the package globs in the configuration
+    bool isPackageFile(const std::filesystem::path& path, const ClientConfiguration& config) const;
+    /// Whether the file matches any of the package globs in the workspace's configuration.
+    /// The result is cached until the config cache is cleared, so this is cheap to call from hot paths
+    bool isPackageFile(const std::filesystem::path& path) const;
+
     const Luau::Config& readConfigRec(const std::filesystem::path& path) const;
 
     void clearConfigCache();
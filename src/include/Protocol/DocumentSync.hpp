@@ -31,4 +31,11 @@ struct DidCloseTextDocumentParams
     TextDocumentIdentifier textDocument;
 };
 NLOHMANN_DEFINE_OPTIONAL(DidCloseTextDocumentParams, textDocument)
+
+struct DidSaveTextDocumentParams
+{
+    TextDocumentIdentifier textDocument;
+    std::optional<std::string> text = std::nullopt;
+};
+NLOHMANN_DEFINE_OPTIONAL(DidSaveTextDocumentParams, textDocument, text)
 } // namespace lsp
\ No newline at end of file
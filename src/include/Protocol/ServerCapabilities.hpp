@@ -30,6 +30,20 @@ enum struct TextDocumentSyncKind
     Incremental = 2,
 };
 
+struct SaveOptions
+{
+    bool includeText = false;
+};
+NLOHMANN_DEFINE_OPTIONAL(SaveOptions, includeText);
+
+struct TextDocumentSyncOptions
+{
+    bool openClose = false;
+    TextDocumentSyncKind change = TextDocumentSyncKind::None;
+    std::optional<SaveOptions> save = std::nullopt;
+};
+NLOHMANN_DEFINE_OPTIONAL(TextDocumentSyncOptions, openClose, change, save);
+
 struct DiagnosticOptions
 {
     std::optional<std::string> identifier = std::nullopt;
@@ -45,12 +59,47 @@ struct WorkspaceFoldersServerCapabilities
 };
 NLOHMANN_DEFINE_OPTIONAL(WorkspaceFoldersServerCapabilities, supported, changeNotifications);
 
+enum struct FileOperationPatternKind
+{
+    File,
+    Folder,
+};
+NLOHMANN_JSON_SERIALIZE_ENUM(FileOperationPatternKind, {{FileOperationPatternKind::File, "file"}, {FileOperationPatternKind::Folder, "folder"}})
+
+struct FileOperationPattern
+{
+    std::string glob;
+    std::optional<FileOperationPatternKind> matches = std::nullopt;
+};
+NLOHMANN_DEFINE_OPTIONAL(FileOperationPattern, glob, matches);
+
+struct FileOperationFilter
+{
+    std::optional<std::string> scheme = std::nullopt;
+    FileOperationPattern pattern;
+};
+NLOHMANN_DEFINE_OPTIONAL(FileOperationFilter, scheme, pattern);
+
+struct FileOperationRegistrationOptions
+{
+    std::vector<FileOperationFilter> filters{};
+};
+NLOHMANN_DEFINE_OPTIONAL(FileOperationRegistrationOptions, filters);
+
+struct FileOperationOptions
+{
+    std::optional<FileOperationRegistrationOptions> didRename = std::nullopt;
+    std::optional<FileOperationRegistrationOptions> didCreate = std::nullopt;
+    std::optional<FileOperationRegistrationOptions> didDelete = std::nullopt;
+};
+NLOHMANN_DEFINE_OPTIONAL(FileOperationOptions, didRename, didCreate, didDelete);
+
 struct WorkspaceCapabilities
 {
     std::optional<WorkspaceFoldersServerCapabilities> workspaceFolders = std::nullopt;
-    // fileOperations
+    std::optional<FileOperationOptions> fileOperations = std::nullopt;
 };
-NLOHMANN_DEFINE_OPTIONAL(WorkspaceCapabilities, workspaceFolders);
+NLOHMANN_DEFINE_OPTIONAL(WorkspaceCapabilities, workspaceFolders, fileOperations);
 
 struct CompletionOptions
 {
@@ -97,7 +146,7 @@ NLOHMANN_DEFINE_OPTIONAL(CodeActionOptions, codeActionKinds, resolveProvider);
 struct ServerCapabilities
 {
     PositionEncodingKind positionEncoding = PositionEncodingKind::UTF16;
-    std::optional<TextDocumentSyncKind> textDocumentSync = std::nullopt;
+    std::optional<TextDocumentSyncOptions> textDocumentSync = std::nullopt;
     std::optional<CompletionOptions> completionProvider = std::nullopt;
     bool hoverProvider = false;
     std::optional<SignatureHelpOptions> signatureHelpProvider = std::nullopt;
@@ -70,6 +70,43 @@ struct DidChangeWatchedFilesParams
 };
 NLOHMANN_DEFINE_OPTIONAL(DidChangeWatchedFilesParams, changes)
 
+struct FileRename
+{
+    DocumentUri oldUri;
+    DocumentUri newUri;
+};
+NLOHMANN_DEFINE_OPTIONAL(FileRename, oldUri, newUri)
+
+struct RenameFilesParams
+{
+    std::vector<FileRename> files{};
+};
+NLOHMANN_DEFINE_OPTIONAL(RenameFilesParams, files)
+
+struct FileCreate
+{
+    DocumentUri uri;
+};
+NLOHMANN_DEFINE_OPTIONAL(FileCreate, uri)
+
+struct CreateFilesParams
+{
+    std::vector<FileCreate> files{};
+};
+NLOHMANN_DEFINE_OPTIONAL(CreateFilesParams, files)
+
+struct FileDelete
+{
+    DocumentUri uri;
+};
+NLOHMANN_DEFINE_OPTIONAL(FileDelete, uri)
+
+struct DeleteFilesParams
+{
+    std::vector<FileDelete> files{};
+};
+NLOHMANN_DEFINE_OPTIONAL(DeleteFilesParams, files)
+
 struct WorkspaceFoldersChangeEvent
 {
     std::vector<WorkspaceFolder> added{};
@@ -48,6 +48,8 @@ static bool validateFlag(char* str, int argIndex)
         return true;
     else if (strcmp(str, "--timetrace") == 0)
         return true;
+    else if (strcmp(str, "--stream") == 0)
+        return true;
     else if (strcmp(str, "--no-strict-dm-types") == 0)
         return true;
     else if (strncmp(str, "--sourcemap=", 12) == 0 && n > 13)
@@ -88,6 +90,7 @@ static void displayHelp(const char* argv0)
     printf("  --formatter=plain: report analysis errors in Luacheck-compatible format\n");
     printf("  --formatter=gnu: report analysis errors in GNU-compatible format\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
+    printf("  --stream: check files in dependency order, releasing each module once the files requiring it are checked, to reduce memory usage\n");
     printf("  --no-strict-dm-types: disable strict DataModel types in type-checking\n");
     printf("  --sourcemap=PATH: path to a Rojo-style sourcemap\n");
     printf("  --definitions=PATH: path to definition file for global types\n");
@@ -98,6 +101,7 @@ static void displayHelp(const char* argv0)
     printf("  --definitions=PATH: path to definition file for global types\n");
     printf("  --docs=PATH: path to documentation file to power Intellisense\n");
     printf("  --base-luaurc=PATH: path to a .luaurc file which acts as the base default configuration\n");
+    printf("  --cache-directory=PATH: path to a directory used to persist diagnostics between sessions\n");
 }
 
 static void displayFlags()
@@ -175,6 +179,7 @@ int startLanguageServer(int argc, char** argv)
     std::vector<std::filesystem::path> definitionsFiles{};
     std::vector<std::filesystem::path> documentationFiles{};
     std::optional<std::filesystem::path> baseLuaurc = std::nullopt;
+    std::optional<std::filesystem::path> cacheDirectory = std::nullopt;
 
     for (int i = 1; i < argc; i++)
     {
@@ -190,6 +195,10 @@ int startLanguageServer(int argc, char** argv)
         {
             baseLuaurc = std::filesystem::path(argv[i] + 14);
         }
+        else if (strncmp(argv[i], "--cache-directory=", 18) == 0)
+        {
+            cacheDirectory = std::filesystem::path(argv[i] + 18);
+        }
     }
 
     std::optional<Luau::Config> defaultConfig = std::nullopt;
@@ -212,7 +221,7 @@ int startLanguageServer(int argc, char** argv)
         }
     }
 
-    LanguageServer server(definitionsFiles, documentationFiles, defaultConfig);
+    LanguageServer server(definitionsFiles, documentationFiles, defaultConfig, cacheDirectory);
 
     // Begin input loop
     server.processInputLoop();
@@ -230,6 +239,10 @@ int main(int argc, char** argv)
     //     d = 4;
     // }
 
+    // Let the standard streams buffer their own input, so that the language server can tell whether the client has already sent another
+    // message while it works. This must happen before any I/O on the standard streams
+    std::ios_base::sync_with_stdio(false);
+
     CliMode mode = CliMode::Lsp;
 
     if (argc < 2)
@@ -127,7 +127,7 @@ std::vector<lsp::CallHierarchyItem> WorkspaceFolder::prepareCallHierarchy(const
         return {};
 
 
-    auto scope = Luau::findScopeAtPosition(*module, position);
+    auto scope = getScopeIndex(module)->findScopeAtPosition(position);
     if (!scope)
         return {};
 
@@ -203,7 +203,8 @@ std::vector<lsp::CallHierarchyItem> WorkspaceFolder::prepareCallHierarchy(const
         return {};
 }
 
-std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomingCalls(const lsp::CallHierarchyIncomingCallsParams& params)
+Resumable<std::vector<lsp::CallHierarchyIncomingCall>> WorkspaceFolder::resumableCallHierarchyIncomingCalls(
+    const lsp::CallHierarchyIncomingCallsParams& params)
 {
     auto moduleName = fileResolver.getModuleName(params.item.uri);
 
@@ -217,107 +218,116 @@ std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomi
     auto sourceModule = frontend.getSourceModule(moduleName);
     auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
     if (!sourceModule || !module)
-        return {};
+        return ready(std::vector<lsp::CallHierarchyIncomingCall>{});
     auto node = Luau::findExprAtPosition(*sourceModule, position);
     if (!node || !node->is<Luau::AstExprFunction>())
-        return {};
+        return ready(std::vector<lsp::CallHierarchyIncomingCall>{});
 
     auto func = node->as<Luau::AstExprFunction>();
     auto ty = module->astTypes.find(func);
     if (!ty)
-        return {};
+        return ready(std::vector<lsp::CallHierarchyIncomingCall>{});
 
     auto followedTy = Luau::follow(*ty);
 
-    std::vector<lsp::CallHierarchyIncomingCall> result;
-
     // Find all reverse dependencies of this module
     std::vector<Luau::ModuleName> dependents = findReverseDependencies(moduleName);
 
     // For each module, search for callers
-    for (const auto& dependentModuleName : dependents)
-    {
-        auto dependentSourceModule = frontend.getSourceModule(dependentModuleName);
-        auto dependentModule = frontend.moduleResolverForAutocomplete.getModule(dependentModuleName);
-        if (!dependentSourceModule || !dependentModule)
-            continue;
-
-        FindAllFunctionsVisitor funcsVisitor;
-        dependentSourceModule->root->visit(&funcsVisitor);
-
-        auto findIncomingCalls = [this, followedTy, &dependentModuleName, &dependentModule, &result](Luau::AstNode* node,
-                                     std::optional<FunctionName> funcName, std::optional<std::pair<Luau::Location, Luau::Location>> locations)
+    return forEach<std::vector<lsp::CallHierarchyIncomingCall>>(
+        std::move(dependents), std::vector<lsp::CallHierarchyIncomingCall>{},
+        [this, followedTy](const Luau::ModuleName& dependentModuleName, std::vector<lsp::CallHierarchyIncomingCall>& result)
         {
-            FindAllCallsVisitor callsVisitor(/* ignoreOtherFunctions = */ true);
-            node->visit(&callsVisitor);
-            if (callsVisitor.calls.empty())
+            auto dependentSourceModule = getSourceModule(dependentModuleName);
+            auto dependentModule = frontend.moduleResolverForAutocomplete.getModule(dependentModuleName);
+            if (!dependentSourceModule || !dependentModule)
                 return;
 
-            // Check if any of the calls match
-            std::vector<const Luau::AstExprCall*> matchingCalls{};
-            for (const auto& call : callsVisitor.calls)
-                if (auto ty2 = lookupFunctionCallType(dependentModule, call))
-                    if (isSameFunction(ty2, followedTy))
-                        matchingCalls.emplace_back(call);
-
-            if (matchingCalls.empty())
-                return;
+            FindAllFunctionsVisitor funcsVisitor;
+            dependentSourceModule->root->visit(&funcsVisitor);
 
-            lsp::CallHierarchyItem item{};
-
-            if (funcName)
-            {
-                item.name = funcName->first;
-                item.detail = funcName->second;
-                item.kind = lsp::SymbolKind::Function;
-            }
-            else
+            auto findIncomingCalls = [this, followedTy, &dependentModuleName, &dependentModule, &result](Luau::AstNode* node,
+                                         std::optional<FunctionName> funcName, std::optional<std::pair<Luau::Location, Luau::Location>> locations)
             {
-                item.name = "<no function>";
-                item.kind = lsp::SymbolKind::Namespace;
-            }
+                FindAllCallsVisitor callsVisitor(/* ignoreOtherFunctions = */ true);
+                node->visit(&callsVisitor);
+                if (callsVisitor.calls.empty())
+                    return;
 
-            std::vector<lsp::Range> convertedRanges{};
-            convertedRanges.reserve(matchingCalls.size());
+                // Check if any of the calls match
+                std::vector<const Luau::AstExprCall*> matchingCalls{};
+                for (const auto& call : callsVisitor.calls)
+                    if (auto ty2 = lookupFunctionCallType(dependentModule, call))
+                        if (isSameFunction(ty2, followedTy))
+                            matchingCalls.emplace_back(call);
 
-            if (auto refTextDocument = fileResolver.getOrCreateTextDocumentFromModuleName(dependentModuleName))
-            {
-                item.uri = refTextDocument->uri();
+                if (matchingCalls.empty())
+                    return;
 
-                if (locations)
+                lsp::CallHierarchyItem item{};
+
+                if (funcName)
                 {
-                    auto [funcLocation, nameLocation] = locations.value();
-                    item.range = {refTextDocument->convertPosition(funcLocation.begin), refTextDocument->convertPosition(funcLocation.end)};
-                    item.selectionRange = {refTextDocument->convertPosition(nameLocation.begin), refTextDocument->convertPosition(nameLocation.end)};
+                    item.name = funcName->first;
+                    item.detail = funcName->second;
+                    item.kind = lsp::SymbolKind::Function;
                 }
                 else
                 {
-                    item.range = {{0, 0}, {refTextDocument->lineCount() - 1, 0}};
-                    item.selectionRange = {{0, 0}, {0, 0}};
+                    item.name = "<no function>";
+                    item.kind = lsp::SymbolKind::Namespace;
                 }
 
-                for (const auto& call : matchingCalls)
-                    convertedRanges.emplace_back(lsp::Range{
-                        refTextDocument->convertPosition(call->func->location.begin), refTextDocument->convertPosition(call->func->location.end)});
-            }
-            else
-                return;
+                std::vector<lsp::Range> convertedRanges{};
+                convertedRanges.reserve(matchingCalls.size());
 
-            lsp::CallHierarchyIncomingCall incomingCall{item, convertedRanges};
-            result.emplace_back(incomingCall);
-        };
+                if (auto refTextDocument = fileResolver.getOrCreateTextDocumentFromModuleName(dependentModuleName))
+                {
+                    item.uri = refTextDocument->uri();
+
+                    if (locations)
+                    {
+                        auto [funcLocation, nameLocation] = locations.value();
+                        item.range = {refTextDocument->convertPosition(funcLocation.begin), refTextDocument->convertPosition(funcLocation.end)};
+                        item.selectionRange = {
+                            refTextDocument->convertPosition(nameLocation.begin), refTextDocument->convertPosition(nameLocation.end)};
+                    }
+                    else
+                    {
+                        item.range = {{0, 0}, {refTextDocument->lineCount() - 1, 0}};
+                        item.selectionRange = {{0, 0}, {0, 0}};
+                    }
+
+                    for (const auto& call : matchingCalls)
+                        convertedRanges.emplace_back(lsp::Range{refTextDocument->convertPosition(call->func->location.begin),
+                            refTextDocument->convertPosition(call->func->location.end)});
+                }
+                else
+                    return;
 
-        for (auto& [funcName, funcLocation, nameLocation, func] : funcsVisitor.funcs)
-        {
-            findIncomingCalls(func, funcName, std::make_pair(funcLocation, nameLocation));
-        }
+                lsp::CallHierarchyIncomingCall incomingCall{item, convertedRanges};
+                result.emplace_back(incomingCall);
+            };
 
-        // Search the root of the AST to find calls outside of functions
-        findIncomingCalls(dependentSourceModule->root, std::nullopt, std::nullopt);
-    }
+            for (auto& [funcName, funcLocation, nameLocation, func] : funcsVisitor.funcs)
+            {
+                findIncomingCalls(func, funcName, std::make_pair(funcLocation, nameLocation));
+            }
 
-    return result;
+            // Search the root of the AST to find calls outside of functions
+            findIncomingCalls(dependentSourceModule->root, std::nullopt, std::nullopt);
+        },
+        [](std::vector<lsp::CallHierarchyIncomingCall>&& result)
+        {
+            return std::move(result);
+        });
 }
+
+std::vector<lsp::CallHierarchyIncomingCall> WorkspaceFolder::callHierarchyIncomingCalls(const lsp::CallHierarchyIncomingCallsParams& params)
+{
+    return runToCompletion(resumableCallHierarchyIncomingCalls(params));
+}
+
 std::vector<lsp::CallHierarchyOutgoingCall> WorkspaceFolder::callHierarchyOutgoingCalls(const lsp::CallHierarchyOutgoingCallsParams& params)
 {
     auto moduleName = fileResolver.getModuleName(params.item.uri);
@@ -316,7 +316,7 @@ void WorkspaceFolder::suggestImports(const Luau::ModuleName& moduleName, const L
     if (!sourceModule || !module)
         return;
 
-    auto scope = Luau::findScopeAtPosition(*module, position);
+    auto scope = getScopeIndex(module)->findScopeAtPosition(position);
     if (!scope)
         return;
 
@@ -450,12 +450,94 @@ void WorkspaceFolder::suggestImports(const Luau::ModuleName& moduleName, const L
     }
 }
 
+WorkspaceFolder::CompletionTables& WorkspaceFolder::getCompletionTables()
+{
+    if (completionTables)
+        return *completionTables;
+
+    completionTableBuildCount += 1;
+    auto& tables = completionTables.emplace();
+    Luau::AutocompleteEntry stringEntry{
+        Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct};
+
+    if (auto instanceType = frontend.globals.globalScope->lookupType("Instance"))
+    {
+        if (auto* ctv = Luau::get<Luau::ClassType>(instanceType->type))
+        {
+            auto& classNames = tables.instanceClassNames.emplace();
+            for (auto& [_, ty] : frontend.globals.globalScope->exportedTypeBindings)
+            {
+                // Check if the class is a subclass of instance
+                if (auto* c = Luau::get<Luau::ClassType>(ty.type); c && Luau::isSubclass(c, ctv))
+                    classNames.insert_or_assign(c->name, stringEntry);
+            }
+        }
+    }
+
+    if (auto it = frontend.globals.globalScope->importedTypeBindings.find("Enum"); it != frontend.globals.globalScope->importedTypeBindings.end())
+    {
+        auto& enumNames = tables.enumNames.emplace();
+        for (auto& [enumName, _] : it->second)
+            enumNames.insert_or_assign(enumName, stringEntry);
+    }
+
+    if (definitionsFileMetadata)
+    {
+        for (const auto& className : definitionsFileMetadata->CREATABLE_INSTANCES)
+            tables.creatableInstances.insert_or_assign(className, stringEntry);
+        for (const auto& className : definitionsFileMetadata->SERVICES)
+            tables.services.insert_or_assign(className, stringEntry);
+    }
+
+    tables.commonServices.insert(std::begin(COMMON_SERVICES), std::end(COMMON_SERVICES));
+    tables.commonInstanceProperties.insert(std::begin(COMMON_INSTANCE_PROPERTIES), std::end(COMMON_INSTANCE_PROPERTIES));
+    tables.commonServiceProviderProperties.insert(std::begin(COMMON_SERVICE_PROVIDER_PROPERTIES), std::end(COMMON_SERVICE_PROVIDER_PROPERTIES));
+
+    if (auto serviceProviderType = frontend.globalsForAutocomplete.globalScope->lookupType("ServiceProvider"))
+        tables.serviceProviderClass = Luau::get<Luau::ClassType>(serviceProviderType->type);
+    if (auto instanceType = frontend.globalsForAutocomplete.globalScope->lookupType("Instance"))
+        tables.instanceClass = Luau::get<Luau::ClassType>(instanceType->type);
+
+    return tables;
+}
+
+const std::unordered_set<std::string>* WorkspaceFolder::CompletionTables::prioritisedProperties(const Luau::ClassType* containingClass)
+{
+    auto [it, inserted] = prioritisedPropertiesByClass.try_emplace(containingClass, nullptr);
+    if (!inserted)
+        return it->second;
+
+    // ServiceProvider derives from Instance, so it is checked first
+    if (serviceProviderClass && Luau::isSubclass(containingClass, serviceProviderClass))
+        it->second = &commonServiceProviderProperties;
+    else if (instanceClass && Luau::isSubclass(containingClass, instanceClass))
+        it->second = &commonInstanceProperties;
+
+    return it->second;
+}
+
 static bool canUseSnippets(const lsp::ClientCapabilities& capabilities)
 {
     return capabilities.textDocument && capabilities.textDocument->completion && capabilities.textDocument->completion->completionItem &&
            capabilities.textDocument->completion->completionItem->snippetSupport;
 }
 
+static bool canWatchFiles(const lsp::ClientCapabilities& capabilities)
+{
+    return capabilities.workspace && capabilities.workspace->didChangeWatchedFiles &&
+           capabilities.workspace->didChangeWatchedFiles->dynamicRegistration;
+}
+
+/// Whether the path is the directory or is contained within it
+static bool isWithinDirectory(const std::filesystem::path& path, const std::filesystem::path& directory)
+{
+    if (directory.empty())
+        return false;
+
+    auto relativePath = path.lexically_normal().lexically_relative(directory.lexically_normal());
+    return !relativePath.empty() && *relativePath.begin() != "..";
+}
+
 std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::CompletionParams& params)
 {
     auto config = client->getConfiguration(rootUri);
@@ -480,6 +562,11 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
     // We must perform check before autocompletion
     checkStrict(moduleName, /* forAutocomplete: */ true);
 
+    // Fetched after checking, as the check builds the autocomplete globals which the tables are derived from
+    auto& tables = getCompletionTables();
+    // Luau takes the callback's entries by value, so a precomputed table is copied exactly once when it is returned, and never rebuilt
+    const auto& stringCompletions = tables;
+
     auto position = textDocument->convertPosition(params.position);
     auto result = Luau::autocomplete(frontend, moduleName, position,
         [&](const std::string& tag, std::optional<const Luau::ClassType*> ctx,
@@ -487,27 +574,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
         {
             if (tag == "ClassNames")
             {
-                if (auto instanceType = frontend.globals.globalScope->lookupType("Instance"))
-                {
-                    if (auto* ctv = Luau::get<Luau::ClassType>(instanceType->type))
-                    {
-                        Luau::AutocompleteEntryMap result;
-                        for (auto& [_, ty] : frontend.globals.globalScope->exportedTypeBindings)
-                        {
-                            if (auto* c = Luau::get<Luau::ClassType>(ty.type))
-                            {
-                                // Check if the ctv is a subclass of instance
-                                if (Luau::isSubclass(c, ctv))
-
-                                    result.insert_or_assign(
-                                        c->name, Luau::AutocompleteEntry{Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType,
-                                                     false, false, Luau::TypeCorrectKind::Correct});
-                            }
-                        }
-
-                        return result;
-                    }
-                }
+                return stringCompletions.instanceClassNames;
             }
             else if (tag == "Properties")
             {
@@ -532,16 +599,7 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
             }
             else if (tag == "Enums")
             {
-                auto it = frontend.globals.globalScope->importedTypeBindings.find("Enum");
-                if (it == frontend.globals.globalScope->importedTypeBindings.end())
-                    return std::nullopt;
-
-                Luau::AutocompleteEntryMap result;
-                for (auto& [enumName, _] : it->second)
-                    result.insert_or_assign(enumName, Luau::AutocompleteEntry{Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType,
-                                                          false, false, Luau::TypeCorrectKind::Correct});
-
-                return result;
+                return stringCompletions.enumNames;
             }
             else if (tag == "Require")
             {
@@ -590,18 +648,19 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
                 std::filesystem::path currentDirectory = resolveDirectoryAlias(rootUri.fsPath(), config.require.directoryAliases, contentsString)
                                                              .value_or(fileResolver.getRequireBasePath(moduleName).append(contentsString));
 
-                try
+                // Directory listings are kept in memory and updated by file watcher events, as this runs on every keystroke within the string.
+                // We never hear about changes without a file watcher, or outside of the workspace (e.g. a directory alias to elsewhere),
+                // so those directories are read from disk every time
+                auto isWatched = canWatchFiles(client->capabilities) && isWithinDirectory(currentDirectory, rootUri.fsPath());
+                auto entries = isWatched ? directoryInventory.list(currentDirectory) : DirectoryInventory::read(currentDirectory);
+                if (entries)
                 {
-                    for (const auto& dir_entry : std::filesystem::directory_iterator(currentDirectory))
+                    for (const auto& dir_entry : *entries)
                     {
-                        if (dir_entry.is_regular_file() || dir_entry.is_directory())
-                        {
-                            std::string fileName = dir_entry.path().filename().generic_string();
-                            Luau::AutocompleteEntry entry{
-                                Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct};
-                            entry.tags.push_back(dir_entry.is_directory() ? "Directory" : "File");
-                            result.insert_or_assign(fileName, entry);
-                        }
+                        Luau::AutocompleteEntry entry{
+                            Luau::AutocompleteEntryKind::String, frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct};
+                        entry.tags.push_back(dir_entry.isDirectory ? "Directory" : "File");
+                        result.insert_or_assign(dir_entry.name, entry);
                     }
 
                     // Add in ".." support
@@ -613,38 +672,19 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
                         result.insert_or_assign("..", dotdotEntry);
                     }
                 }
-                catch (std::exception&)
-                {
-                }
 
                 return result;
             }
             else if (tag == "CreatableInstances")
             {
-                Luau::AutocompleteEntryMap result;
-                if (definitionsFileMetadata)
-                {
-                    for (const auto& className : this->definitionsFileMetadata->CREATABLE_INSTANCES)
-                        result.insert_or_assign(className, Luau::AutocompleteEntry{Luau::AutocompleteEntryKind::String,
-                                                               frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct});
-                }
-                return result;
+                return stringCompletions.creatableInstances;
             }
             else if (tag == "Services")
             {
-                Luau::AutocompleteEntryMap result;
-
                 // We are autocompleting a `game:GetService("$1")` call, so we set a flag to
                 // highlight this so that we can prioritise common services first in the list
                 isGetService = true;
-                if (definitionsFileMetadata)
-                {
-                    for (const auto& className : this->definitionsFileMetadata->SERVICES)
-                        result.insert_or_assign(className, Luau::AutocompleteEntry{Luau::AutocompleteEntryKind::String,
-                                                               frontend.builtinTypes->stringType, false, false, Luau::TypeCorrectKind::Correct});
-                }
-
-                return result;
+                return stringCompletions.services;
             }
 
             return std::nullopt;
@@ -685,27 +725,12 @@ std::vector<lsp::CompletionItem> WorkspaceFolder::completion(const lsp::Completi
             item.sortText = SortText::Keywords;
 
         // If its a `game:GetSerivce("$1")` call, then prioritise common services
-        if (isGetService)
-        {
-            if (auto it = std::find(std::begin(COMMON_SERVICES), std::end(COMMON_SERVICES), name); it != std::end(COMMON_SERVICES))
-                item.sortText = SortText::PrioritisedSuggestion;
-        }
-        // If calling a property on ServiceProvider, then prioritise these properties
-        if (auto dataModelType = frontend.globalsForAutocomplete.globalScope->lookupType("ServiceProvider");
-            dataModelType && Luau::get<Luau::ClassType>(dataModelType->type) && entry.containingClass &&
-            Luau::isSubclass(entry.containingClass.value(), Luau::get<Luau::ClassType>(dataModelType->type)) && !entry.wrongIndexType)
-        {
-            if (auto it = std::find(std::begin(COMMON_SERVICE_PROVIDER_PROPERTIES), std::end(COMMON_SERVICE_PROVIDER_PROPERTIES), name);
-                it != std::end(COMMON_SERVICE_PROVIDER_PROPERTIES))
-                item.sortText = SortText::PrioritisedSuggestion;
-        }
-        // If calling a property on an Instance, then prioritise these properties
-        else if (auto instanceType = frontend.globalsForAutocomplete.globalScope->lookupType("Instance");
-                 instanceType && Luau::get<Luau::ClassType>(instanceType->type) && entry.containingClass &&
-                 Luau::isSubclass(entry.containingClass.value(), Luau::get<Luau::ClassType>(instanceType->type)) && !entry.wrongIndexType)
+        if (isGetService && contains(tables.commonServices, name))
+            item.sortText = SortText::PrioritisedSuggestion;
+        // If calling a property on ServiceProvider or an Instance, then prioritise their common properties
+        if (entry.containingClass && !entry.wrongIndexType)
         {
-            if (auto it = std::find(std::begin(COMMON_INSTANCE_PROPERTIES), std::end(COMMON_INSTANCE_PROPERTIES), name);
-                it != std::end(COMMON_INSTANCE_PROPERTIES))
+            if (auto prioritised = tables.prioritisedProperties(*entry.containingClass); prioritised && contains(*prioritised, name))
                 item.sortText = SortText::PrioritisedSuggestion;
         }
 
@@ -2,8 +2,15 @@
 #include "LSP/LanguageServer.hpp"
 #include "LSP/Client.hpp"
 #include "LSP/LuauExt.hpp"
+#include "Luau/Linter.h"
 
-lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::DocumentDiagnosticParams& params)
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <set>
+#include <unordered_set>
+
+lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::DocumentDiagnosticParams& params, bool allowDeferredTypeCheck)
 {
     if (!isConfigured)
     {
@@ -11,7 +18,6 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
         throw JsonRpcException(lsp::ErrorCode::ServerCancelled, "server not yet received configuration for diagnostics", cancellationData);
     }
 
-    // TODO: should we apply a resultId and return an unchanged report if unchanged?
     lsp::DocumentDiagnosticReport report;
     std::unordered_map<std::string /* lsp::DocumentUri */, std::vector<lsp::Diagnostic>> relatedDiagnostics{};
 
@@ -20,37 +26,66 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
     if (!textDocument)
         return report; // Bail early with empty report - file was likely closed
 
+    auto config = client->getConfiguration(rootUri);
+
+    if (allowDeferredTypeCheck && !isDefinitionFile(params.textDocument.uri.fsPath(), config))
+    {
+        // If the module has not been checked yet, show the diagnostics from the previous session whilst we check it in the background.
+        // Otherwise, if checking requires its dependencies to be checked first, show the diagnostics which do not need type information
+        auto deferredDiagnostics = takeWarmStartDiagnostics(moduleName, config);
+        if (!deferredDiagnostics)
+            deferredDiagnostics = computeSyntaxDiagnostics(moduleName, textDocument, config);
+
+        if (deferredDiagnostics)
+        {
+            deferTypeCheck(params.textDocument.uri, *deferredDiagnostics);
+            report.items = std::move(*deferredDiagnostics);
+            return report;
+        }
+    }
+
     // Check the module.
     // TODO: We do not need to store the type graphs. But it leads to a bad bug if we disable it
     // so for now, we keep the type graphs
     // https://github.com/Roblox/luau/issues/975
-    Luau::CheckResult cr =
-        frontend.check(moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, /* forAutocomplete: */ false, /* runLintChecks: */ true});
+    Luau::CheckResult cr;
+    {
+        tracing::ScopedSpan span("frontend.check", moduleName);
+        applyInterfaceStubs(moduleName, config);
+        checkCount += 1;
+        cr = frontend.check(
+            moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, /* forAutocomplete: */ false, /* runLintChecks: */ true});
+    }
+    hasUncompactedTypeGraphs = true;
 
     // If there was an error retrieving the source module
     // Bail early with an empty report - it is likely that the file was closed
     if (!frontend.getSourceModule(moduleName))
         return report;
 
-    auto config = client->getConfiguration(rootUri);
-
     // If the file is a definitions file, then don't display any diagnostics
     if (isDefinitionFile(params.textDocument.uri.fsPath(), config))
         return report;
 
     // Report Type Errors
     // Note that type errors can extend to related modules in the require graph - so we report related information here
+    auto& typeErrorDiagnostics = lastTypeErrorDiagnostics[moduleName];
+    typeErrorDiagnostics.clear();
     for (auto& error : cr.errors)
     {
         if (error.moduleName == moduleName)
         {
             auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, textDocument);
             report.items.emplace_back(diagnostic);
+
+            // Syntax errors are always recomputed when reporting diagnostics without type checking
+            if (!Luau::get_if<Luau::SyntaxError>(&error.data))
+                typeErrorDiagnostics.emplace_back(diagnostic);
         }
         else
         {
             auto fileName = fileResolver.resolveToRealPath(error.moduleName);
-            if (!fileName || isIgnoredFile(*fileName, config))
+            if (!fileName || isIgnoredFile(*fileName, config) || fileResolver.isPackageFile(*fileName, config))
                 continue;
             auto textDocument = fileResolver.getTextDocumentFromModuleName(error.moduleName);
             auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, textDocument);
@@ -82,115 +117,722 @@ lsp::DocumentDiagnosticReport WorkspaceFolder::documentDiagnostics(const lsp::Do
     for (auto& error : cr.lintResult.warnings)
         report.items.emplace_back(createLintDiagnostic(error, textDocument));
 
+    diagnosticsCache.record(moduleName, report.items);
+
     return report;
 }
 
-lsp::WorkspaceDiagnosticReport WorkspaceFolder::workspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params)
+// Computes a diagnostic report containing only the errors of the given file, as used for workspace diagnostics.
+// Returns std::nullopt if the source module could not be retrieved
+std::optional<lsp::WorkspaceDocumentDiagnosticReport> WorkspaceFolder::computeDocumentReport(const Uri& uri, const ClientConfiguration& config)
+{
+    auto moduleName = fileResolver.getModuleName(uri);
+    auto document = fileResolver.getTextDocument(uri);
+
+    lsp::WorkspaceDocumentDiagnosticReport documentReport;
+    documentReport.uri = uri;
+    documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
+    if (document)
+        documentReport.version = document->version();
+
+    // Compute new check result
+    Luau::CheckResult cr;
+    {
+        tracing::ScopedSpan span("frontend.check", moduleName);
+        // The module may have been substituted when checking one of its dependents, but its own diagnostics need its real source
+        if (contains(interfaceStubs, moduleName))
+            invalidationLog.record(InvalidationCause::InterfaceStubReleased, moduleName, releaseInterfaceStub(moduleName));
+        checkCount += 1;
+        cr = frontend.check(
+            moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, /* forAutocomplete: */ false, /* runLintChecks: */ true});
+    }
+    hasUncompactedTypeGraphs = true;
+
+    if (!getSourceModule(moduleName))
+        return std::nullopt;
+
+    // Report Type Errors
+    // Only report errors for the current file
+    for (auto& error : cr.errors)
+    {
+        if (error.moduleName == moduleName)
+        {
+            auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, document);
+            documentReport.items.emplace_back(diagnostic);
+        }
+    }
+
+    // Report Lint Warnings
+    for (auto& error : cr.lintResult.errors)
+    {
+        auto diagnostic = createLintDiagnostic(error, document);
+        diagnostic.severity = lsp::DiagnosticSeverity::Error; // Report this as an error instead
+        documentReport.items.emplace_back(diagnostic);
+    }
+    for (auto& error : cr.lintResult.warnings)
+        documentReport.items.emplace_back(createLintDiagnostic(error, document));
+
+    diagnosticsCache.record(moduleName, documentReport.items);
+
+    if (documentReport.items.empty())
+        workspaceReportedUris.erase(uri.toString());
+    else
+        workspaceReportedUris.insert(uri.toString());
+
+    return documentReport;
+}
+
+// Creates an empty diagnostic report for the given file, which clears any diagnostics previously reported for it
+lsp::WorkspaceDocumentDiagnosticReport WorkspaceFolder::clearingDocumentReport(const Uri& uri)
 {
-    lsp::WorkspaceDiagnosticReport workspaceReport;
+    lsp::WorkspaceDocumentDiagnosticReport documentReport;
+    documentReport.uri = uri;
+    documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
+    if (auto document = fileResolver.getTextDocument(uri))
+        documentReport.version = document->version();
+    workspaceReportedUris.erase(uri.toString());
+    return documentReport;
+}
 
+Resumable<lsp::WorkspaceDiagnosticReport> WorkspaceFolder::resumableWorkspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params)
+{
     // Don't compute any workspace diagnostics for null workspace
     if (isNullWorkspace())
-        return workspaceReport;
+        return ready(lsp::WorkspaceDiagnosticReport{});
 
     auto config = client->getConfiguration(rootUri);
 
     // Find a list of files to compute diagnostics for
     std::vector<Uri> files{};
-    for (std::filesystem::recursive_directory_iterator next(this->rootUri.fsPath()), end; next != end; ++next)
+    std::unordered_set<std::string> walkedUris{};
+    walkSourceFiles(rootUri.fsPath(), getDirectoryWalkRules(config),
+        [&](const std::filesystem::path& path)
+        {
+            auto uri = Uri::file(path);
+            walkedUris.insert(uri.toString());
+            if (!isDefinitionFile(path, config))
+                files.push_back(uri);
+            return true;
+        });
+
+    // Files within pruned directories are never walked, so clear the diagnostics of any such file that were reported before
+    std::set<std::string> staleUris{};
+    for (const auto& [uri, reported] : reportedDiagnostics)
+        if (!reported.items.empty())
+            staleUris.insert(uri);
+    staleUris.insert(workspaceReportedUris.begin(), workspaceReportedUris.end());
+
+    lsp::WorkspaceDiagnosticReport initialReport{};
+    for (const auto& uri : staleUris)
     {
-        if (next->is_regular_file() && next->path().has_extension() && !isDefinitionFile(next->path(), config))
+        auto parsedUri = Uri::parse(uri);
+        if (parsedUri.scheme == "file" && walkedUris.find(uri) == walkedUris.end())
+            initialReport.items.emplace_back(clearingDocumentReport(parsedUri));
+    }
+
+    // Each file is checked in a separate unit of work
+    return forEach<lsp::WorkspaceDiagnosticReport>(
+        std::move(files), std::move(initialReport),
+        [this, config](const Uri& uri, lsp::WorkspaceDiagnosticReport& workspaceReport)
         {
-            auto ext = next->path().extension();
-            if (ext == ".lua" || ext == ".luau")
-                files.push_back(Uri::file(next->path()));
-        }
+            // If we don't have workspace diagnostics enabled, or we are are ignoring this file, or it is a package file
+            // Then provide an empty report to clear the file diagnostics
+            if (!config.diagnostics.workspace || isIgnoredFile(uri, config) || fileResolver.isPackageFile(uri, config))
+            {
+                workspaceReport.items.emplace_back(clearingDocumentReport(uri));
+                return;
+            }
+
+            // If there was an error retrieving the source module, disregard this file
+            // TODO: should we file a diagnostic?
+            if (auto documentReport = computeDocumentReport(uri, config))
+                workspaceReport.items.emplace_back(*documentReport);
+        },
+        [](lsp::WorkspaceDiagnosticReport&& workspaceReport)
+        {
+            return std::move(workspaceReport);
+        });
+}
+
+lsp::WorkspaceDiagnosticReport WorkspaceFolder::workspaceDiagnostics(const lsp::WorkspaceDiagnosticParams& params)
+{
+    return runToCompletion(resumableWorkspaceDiagnostics(params));
+}
+
+void WorkspaceFolder::queueDependentDiagnostics(const Luau::ModuleName& changedModule, const std::vector<Luau::ModuleName>& markedDirty)
+{
+    if (markedDirty.empty())
+        return;
+
+    // Compute the distance of each dependent from the changed module using a BFS over the reverse require graph,
+    // so that the closest dependents are recomputed first
+    std::unordered_map<Luau::ModuleName, std::vector<Luau::ModuleName>> reverseDeps;
+    for (const auto& [moduleName, sourceNode] : frontend.sourceNodes)
+    {
+        for (const auto& dep : sourceNode->requireSet)
+            reverseDeps[dep].push_back(moduleName);
     }
 
-    for (auto uri : files)
+    std::unordered_map<Luau::ModuleName, size_t> distances{{changedModule, 0}};
+    std::deque<Luau::ModuleName> queue{changedModule};
+    while (!queue.empty())
     {
-        auto moduleName = fileResolver.getModuleName(uri);
-        auto document = fileResolver.getTextDocument(uri);
+        auto next = std::move(queue.front());
+        queue.pop_front();
 
-        lsp::WorkspaceDocumentDiagnosticReport documentReport;
-        documentReport.uri = uri;
-        documentReport.kind = lsp::DocumentDiagnosticReportKind::Full;
-        if (document)
-            documentReport.version = document->version();
+        auto it = reverseDeps.find(next);
+        if (it == reverseDeps.end())
+            continue;
 
-        // If we don't have workspace diagnostics enabled, or we are are ignoring this file
-        // Then provide an empty report to clear the file diagnostics
-        if (!config.diagnostics.workspace || isIgnoredFile(uri, config))
+        auto distance = distances.at(next) + 1;
+        for (const auto& dependent : it->second)
         {
-            workspaceReport.items.emplace_back(documentReport);
-            continue;
+            if (distances.emplace(dependent, distance).second)
+                queue.push_back(dependent);
         }
+    }
 
-        // Compute new check result
-        Luau::CheckResult cr = frontend.check(
-            moduleName, Luau::FrontendOptions{/* retainFullTypeGraphs: */ true, /* forAutocomplete: */ false, /* runLintChecks: */ true});
+    for (const auto& moduleName : markedDirty)
+    {
+        if (moduleName == changedModule)
+            continue;
+
+        // Modules we could not reach are placed at the back of the queue
+        auto distanceIt = distances.find(moduleName);
+        auto distance = distanceIt != distances.end() ? distanceIt->second : std::numeric_limits<size_t>::max();
+
+        auto [it, inserted] = pendingDependentDiagnostics.emplace(moduleName, distance);
+        if (!inserted)
+            it->second = std::min(it->second, distance);
+    }
+}
+
+bool WorkspaceFolder::processDependentDiagnostics(std::chrono::milliseconds budget)
+{
+    if (pendingDependentDiagnostics.empty())
+        return false;
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto config = client->getConfiguration(rootUri);
+
+    // Prioritise currently opened documents, then the modules closest to the change
+    std::vector<std::tuple<bool, size_t, Luau::ModuleName>> ordered;
+    ordered.reserve(pendingDependentDiagnostics.size());
+    for (const auto& [moduleName, distance] : pendingDependentDiagnostics)
+        ordered.emplace_back(fileResolver.getTextDocumentFromModuleName(moduleName) == nullptr, distance, moduleName);
+    std::sort(ordered.begin(), ordered.end());
+
+    lsp::WorkspaceDiagnosticReportPartialResult partialResult;
+
+    for (const auto& [isClosed, _, moduleName] : ordered)
+    {
+        if (std::chrono::steady_clock::now() - startTime >= budget)
+            break;
+
+        pendingDependentDiagnostics.erase(moduleName);
 
-        // If there was an error retrieving the source module, disregard this file
-        // TODO: should we file a diagnostic?
-        if (!frontend.getSourceModule(moduleName))
+        auto filePath = fileResolver.resolveToRealPath(moduleName);
+        if (!filePath || isIgnoredFile(*filePath, config) || isDefinitionFile(*filePath, config) || fileResolver.isPackageFile(*filePath, config))
             continue;
 
-        // Report Type Errors
-        // Only report errors for the current file
-        for (auto& error : cr.errors)
+        // Diagnostics for closed files are only shown when workspace diagnostics are enabled
+        if (isClosed && !config.diagnostics.workspace)
+            continue;
+
+        auto report = computeDocumentReport(Uri::file(*filePath), config);
+        if (!report)
+            continue;
+
+        if (isClosed)
+            partialResult.items.emplace_back(*report);
+        else
+            refreshAfterDependentDiagnostics = true;
+    }
+
+    // Stream the results for closed files as part of the ongoing workspace diagnostics request.
+    // If there is no request to stream into, then request the client to pull diagnostics again
+    if (!partialResult.items.empty())
+    {
+        if (client->workspaceDiagnosticsToken)
+            client->sendProgress({client->workspaceDiagnosticsToken.value(), partialResult});
+        else
+            refreshAfterDependentDiagnostics = true;
+    }
+
+    // The open documents have already been checked, so the client pulling their diagnostics will be cheap.
+    // We wait until all dependents are processed (possibly over several passes) so that we do not repeatedly refresh
+    if (refreshAfterDependentDiagnostics && pendingDependentDiagnostics.empty())
+    {
+        refreshAfterDependentDiagnostics = false;
+        client->refreshWorkspaceDiagnostics();
+    }
+
+    return !pendingDependentDiagnostics.empty();
+}
+
+/// The state shared by all modules which affects their diagnostics and interfaces. Cached data computed in a different environment is discarded
+std::string WorkspaceFolder::getCacheEnvironmentHash(const ClientConfiguration& config)
+{
+    return hashString(definitionsHash + json(config).dump() + json(positionEncoding()).dump());
+}
+
+/// Computes the hash of the interface of a module. If the module has been checked in this session, the interface is computed directly.
+/// Otherwise, we use the interface hash from the previous session if the module's contents and the interfaces of its dependencies are unchanged.
+/// Returns std::nullopt if the interface is unknown
+std::optional<std::string> WorkspaceFolder::getInterfaceHash(
+    const Luau::ModuleName& moduleName, const std::string& environmentHash, std::unordered_map<Luau::ModuleName, std::optional<std::string>>& visited)
+{
+    if (auto it = visited.find(moduleName); it != visited.end())
+        return it->second;
+
+    // A stub is only substituted whilst the interface it declares is unchanged
+    if (auto stub = interfaceStubs.find(moduleName); stub != interfaceStubs.end())
+        return visited.insert_or_assign(moduleName, stub->second.interfaceHash).first->second;
+
+    // Mark the module as unknown whilst we compute it, so that cyclic requires are treated as unknown
+    visited.emplace(moduleName, std::nullopt);
+
+    std::optional<std::string> result = std::nullopt;
+    auto source = fileResolver.readSource(moduleName);
+    if (!source)
+    {
+        // The required module does not exist. This still forms part of the interface of the dependent
+        result = "";
+    }
+    else if (!frontend.isDirty(moduleName))
+    {
+        if (auto module = frontend.moduleResolver.getModule(moduleName))
+            result = hashModuleInterface(serializeModuleInterface(*module));
+    }
+    else if (auto cached = moduleInterfaceCache.find(moduleName, environmentHash); cached && cached->contentHash == hashString(source->source))
+    {
+        auto dependencyHash = computeDependencyHash(moduleName, environmentHash, visited);
+        if (dependencyHash && *dependencyHash == cached->dependencyHash)
+            result = cached->interfaceHash;
+    }
+
+    visited.insert_or_assign(moduleName, result);
+    return result;
+}
+
+/// Hashes the interfaces of all modules the given module directly requires. The module must already be parsed so that its dependencies are known
+std::optional<std::string> WorkspaceFolder::computeDependencyHash(
+    const Luau::ModuleName& moduleName, const std::string& environmentHash, std::unordered_map<Luau::ModuleName, std::optional<std::string>>& visited)
+{
+    auto it = frontend.sourceNodes.find(moduleName);
+    if (it == frontend.sourceNodes.end())
+        return std::nullopt;
+
+    // Sort the dependencies so that the hash is not affected by iteration order
+    std::set<Luau::ModuleName> dependencies(it->second->requireSet.begin(), it->second->requireSet.end());
+
+    std::string dependencyHashes;
+    for (const auto& dependency : dependencies)
+    {
+        auto interfaceHash = getInterfaceHash(dependency, environmentHash, visited);
+        if (!interfaceHash)
+            return std::nullopt;
+        dependencyHashes += dependency + ':' + *interfaceHash + ';';
+    }
+
+    return hashString(dependencyHashes);
+}
+
+/// Hashes the contents of the module, and the interfaces of the modules it depends on.
+/// Changes to a dependency which do not affect its interface do not affect the module's diagnostics
+std::optional<ModuleHashes> WorkspaceFolder::computeModuleHashes(
+    const Luau::ModuleName& moduleName, const std::string& environmentHash, std::unordered_map<Luau::ModuleName, std::optional<std::string>>& visited)
+{
+    auto source = fileResolver.readSource(moduleName);
+    if (!source)
+        return std::nullopt;
+
+    auto dependencyHash = computeDependencyHash(moduleName, environmentHash, visited);
+    if (!dependencyHash)
+        return std::nullopt;
+
+    return ModuleHashes{hashString(source->source), *dependencyHash};
+}
+
+/// Retrieves the diagnostics for a module persisted in the previous session, if the module has not yet been checked in this session
+/// and its contents and dependencies are unchanged
+std::optional<std::vector<lsp::Diagnostic>> WorkspaceFolder::takeWarmStartDiagnostics(
+    const Luau::ModuleName& moduleName, const ClientConfiguration& config)
+{
+    if (!diagnosticsCache.isEnabled() || !frontend.isDirty(moduleName))
+        return std::nullopt;
+
+    // Entries are only ever served once: afterwards, we will always perform a proper type check
+    auto environmentHash = getCacheEnvironmentHash(config);
+    auto entry = diagnosticsCache.take(moduleName, environmentHash);
+    if (!entry)
+        return std::nullopt;
+
+    // Parsing is cheap compared to type checking, and lets us find the dependencies of the module
+    frontend.parse(moduleName);
+
+    std::unordered_map<Luau::ModuleName, std::optional<std::string>> visited;
+    auto hashes = computeModuleHashes(moduleName, environmentHash, visited);
+    if (!hashes || hashes->contentHash != entry->contentHash || hashes->dependencyHash != entry->dependencyHash)
+        return std::nullopt;
+
+    return std::move(entry->diagnostics);
+}
+
+/// Substitutes the interfaces checked in the previous session for the unchecked dependencies of the module, so that checking the module
+/// does not require checking the real sources of its dependencies first. A dependency is only substituted if its contents and the
+/// interfaces of its own dependencies are unchanged, in which case its interface is unchanged too
+void WorkspaceFolder::applyInterfaceStubs(const Luau::ModuleName& moduleName, const ClientConfiguration& config)
+{
+    if (!moduleInterfaceCache.isEnabled() || !frontend.isDirty(moduleName))
+        return;
+
+    // Parsing is cheap compared to type checking, and lets us find the dependencies of the module
+    frontend.parse(moduleName);
+
+    auto environmentHash = getCacheEnvironmentHash(config);
+    std::unordered_map<Luau::ModuleName, std::optional<std::string>> visited;
+    std::vector<Luau::ModuleName> applied;
+
+    // The dependencies of a substituted module are no longer required, so they are not traversed
+    std::unordered_set<Luau::ModuleName> seen{moduleName};
+    std::vector<Luau::ModuleName> queue{moduleName};
+    while (!queue.empty())
+    {
+        auto current = std::move(queue.back());
+        queue.pop_back();
+
+        auto sourceNode = frontend.sourceNodes.find(current);
+        if (sourceNode == frontend.sourceNodes.end())
+            continue;
+
+        for (const auto& dependency : sourceNode->second->requireSet)
         {
-            if (error.moduleName == moduleName)
+            if (!seen.insert(dependency).second || contains(interfaceStubs, dependency))
+                continue;
+
+            // Open documents may differ from the contents the interface was computed from
+            auto dependencyNode = frontend.sourceNodes.find(dependency);
+            auto cached = moduleInterfaceCache.find(dependency, environmentHash);
+            bool substitutable = dependencyNode != frontend.sourceNodes.end() && frontend.isDirty(dependency) && cached && cached->stub &&
+                                 !fileResolver.getTextDocumentFromModuleName(dependency) &&
+                                 getInterfaceHash(dependency, environmentHash, visited) == cached->interfaceHash;
+            if (!substitutable)
             {
-                auto diagnostic = createTypeErrorDiagnostic(error, &fileResolver, document);
-                documentReport.items.emplace_back(diagnostic);
+                queue.push_back(dependency);
+                continue;
             }
+
+            auto& node = dependencyNode->second;
+            std::unordered_set<Luau::ModuleName> requireSet(node->requireSet.begin(), node->requireSet.end());
+            interfaceStubs.insert_or_assign(dependency, InterfaceStub{std::move(requireSet), cached->interfaceHash});
+            fileResolver.interfaceStubs.insert_or_assign(dependency, *cached->stub);
+
+            // The real source was parsed above, so the stub must be read in its place
+            node->dirtySourceModule = true;
+            applied.push_back(dependency);
         }
+    }
 
-        // Report Lint Warnings
-        for (auto& error : cr.lintResult.errors)
+    // Checking a stub is cheap, as it only contains declarations. A stub which does not check cleanly would give its dependents
+    // different results to the real module (e.g. it names a type which is not in scope), so the real module is checked instead
+    for (const auto& dependency : applied)
+    {
+        checkCount += 1;
+        auto result = frontend.check(
+            dependency, Luau::FrontendOptions{/* retainFullTypeGraphs: */ false, /* forAutocomplete: */ false, /* runLintChecks: */ false});
+        if (!result.errors.empty())
+            releaseInterfaceStub(dependency);
+    }
+}
+
+/// Replaces the interface stub of the module with its real source, marking the module and its dependents for rechecking.
+/// Returns the modules marked dirty
+std::vector<Luau::ModuleName> WorkspaceFolder::releaseInterfaceStub(const Luau::ModuleName& moduleName)
+{
+    interfaceStubs.erase(moduleName);
+    fileResolver.interfaceStubs.erase(moduleName);
+
+    std::vector<Luau::ModuleName> invalidated;
+    frontend.markDirty(moduleName, &invalidated);
+    return invalidated;
+}
+
+/// Releases the stubs of invalidated modules, and of modules whose real dependencies were invalidated, as their interfaces may have changed.
+/// Releasing a stub invalidates its dependents, which are appended to the invalidated modules and may in turn release further stubs
+void WorkspaceFolder::releaseInvalidatedInterfaceStubs(std::vector<Luau::ModuleName>& invalidated)
+{
+    std::unordered_set<Luau::ModuleName> invalidatedSet(invalidated.begin(), invalidated.end());
+    auto isInvalidated = [&](const Luau::ModuleName& name)
+    {
+        return contains(invalidatedSet, name);
+    };
+
+    while (true)
+    {
+        std::vector<Luau::ModuleName> affected;
+        for (const auto& [moduleName, stub] : interfaceStubs)
+            if (isInvalidated(moduleName) || std::any_of(stub.requireSet.begin(), stub.requireSet.end(), isInvalidated))
+                affected.push_back(moduleName);
+
+        if (affected.empty())
+            break;
+
+        for (const auto& moduleName : affected)
         {
-            auto diagnostic = createLintDiagnostic(error, document);
-            diagnostic.severity = lsp::DiagnosticSeverity::Error; // Report this as an error instead
-            documentReport.items.emplace_back(diagnostic);
+            for (auto& released : releaseInterfaceStub(moduleName))
+            {
+                if (invalidatedSet.insert(released).second)
+                    invalidated.push_back(std::move(released));
+            }
         }
-        for (auto& error : cr.lintResult.warnings)
-            documentReport.items.emplace_back(createLintDiagnostic(error, document));
+    }
+}
+
+/// Replaces every interface stub with the module's real source, for features which need the syntax trees and definitions of dependencies
+void WorkspaceFolder::releaseInterfaceStubs()
+{
+    while (!interfaceStubs.empty())
+    {
+        auto moduleName = interfaceStubs.begin()->first;
+        invalidationLog.record(InvalidationCause::InterfaceStubReleased, moduleName, releaseInterfaceStub(moduleName));
+    }
+}
+
+/// Computes the diagnostics of a module which do not require type checking: syntax errors and lints.
+/// The type errors from the previous check are carried over, as they are likely to still be relevant.
+/// Returns std::nullopt if the module can be checked quickly, as all of its dependencies have already been checked
+std::optional<std::vector<lsp::Diagnostic>> WorkspaceFolder::computeSyntaxDiagnostics(
+    const Luau::ModuleName& moduleName, const TextDocument* textDocument, const ClientConfiguration& config)
+{
+    if (!config.diagnostics.syntaxFirst || !frontend.isDirty(moduleName))
+        return std::nullopt;
+
+    frontend.parse(moduleName);
+
+    auto sourceModule = frontend.getSourceModule(moduleName);
+    if (!sourceModule || !sourceModule->root)
+        return std::nullopt;
+
+    bool hasDirtyDependencies = false;
+    std::unordered_set<Luau::ModuleName> seen{moduleName};
+    std::vector<Luau::ModuleName> queue{moduleName};
+    while (!queue.empty() && !hasDirtyDependencies)
+    {
+        auto next = std::move(queue.back());
+        queue.pop_back();
+
+        auto it = frontend.sourceNodes.find(next);
+        if (it == frontend.sourceNodes.end())
+            continue;
+
+        for (const auto& dependency : it->second->requireSet)
+        {
+            if (!seen.insert(dependency).second)
+                continue;
+
+            if (frontend.isDirty(dependency))
+            {
+                hasDirtyDependencies = true;
+                break;
+            }
+            queue.push_back(dependency);
+        }
+    }
 
-        workspaceReport.items.emplace_back(documentReport);
+    if (!hasDirtyDependencies)
+        return std::nullopt;
+
+    std::vector<lsp::Diagnostic> diagnostics;
+    for (const auto& error : sourceModule->parseErrors)
+        diagnostics.emplace_back(createParseErrorDiagnostic(error, textDocument));
+
+    // Run the lints which the frontend would have run as part of checking the module
+    const auto& luauConfig = fileResolver.getConfig(moduleName);
+    auto mode = sourceModule->mode.value_or(luauConfig.mode);
+    auto lintOptions = luauConfig.enabledLint;
+    lintOptions.warningMask &= ~Luau::LintWarning::parseMask(sourceModule->hotcomments);
+    if (mode != Luau::Mode::NoCheck)
+        lintOptions.disableWarning(Luau::LintWarning::Code_UnknownGlobal);
+    if (mode == Luau::Mode::Strict)
+        lintOptions.disableWarning(Luau::LintWarning::Code_ImplicitReturn);
+
+    auto warnings =
+        Luau::lint(sourceModule->root, *sourceModule->names, frontend.globals.globalScope, nullptr, sourceModule->hotcomments, lintOptions);
+    for (const auto& warning : warnings)
+    {
+        auto diagnostic = createLintDiagnostic(warning, textDocument);
+        if (luauConfig.lintErrors || luauConfig.fatalLint.isEnabled(warning.code))
+            diagnostic.severity = lsp::DiagnosticSeverity::Error; // Report this as an error instead
+        diagnostics.emplace_back(diagnostic);
     }
 
-    return workspaceReport;
+    if (auto it = lastTypeErrorDiagnostics.find(moduleName); it != lastTypeErrorDiagnostics.end())
+        diagnostics.insert(diagnostics.end(), it->second.begin(), it->second.end());
+
+    return diagnostics;
 }
 
-lsp::DocumentDiagnosticReport LanguageServer::documentDiagnostic(const lsp::DocumentDiagnosticParams& params)
+void WorkspaceFolder::deferTypeCheck(const lsp::DocumentUri& uri, const std::vector<lsp::Diagnostic>& servedDiagnostics)
 {
-    auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->documentDiagnostics(params);
+    auto it = std::find_if(pendingDeferredTypeChecks.begin(), pendingDeferredTypeChecks.end(),
+        [&uri](const DeferredTypeCheck& check)
+        {
+            return check.uri == uri;
+        });
+    if (it != pendingDeferredTypeChecks.end())
+        pendingDeferredTypeChecks.erase(it);
+
+    // The most recently requested document is checked first
+    pendingDeferredTypeChecks.push_back(DeferredTypeCheck{uri, servedDiagnostics});
 }
 
-lsp::PartialResponse<lsp::WorkspaceDiagnosticReport> LanguageServer::workspaceDiagnostic(const lsp::WorkspaceDiagnosticParams& params)
+bool WorkspaceFolder::processDeferredTypeCheck()
 {
-    lsp::WorkspaceDiagnosticReport fullReport;
+    if (pendingDeferredTypeChecks.empty())
+        return false;
 
-    for (auto& workspace : workspaceFolders)
+    auto deferred = std::move(pendingDeferredTypeChecks.back());
+    pendingDeferredTypeChecks.pop_back();
+
+    auto textDocument = fileResolver.getTextDocument(deferred.uri);
+    if (!textDocument)
+        return true; // The document has since been closed
+
+    auto diagnostics = documentDiagnostics(lsp::DocumentDiagnosticParams{{deferred.uri}});
+
+    // Only update the client if the diagnostics were different to the ones we served
+    if (json(diagnostics.items) == json(deferred.servedDiagnostics) && diagnostics.relatedDocuments.empty())
+        return true;
+
+    if (!client->capabilities.textDocument || !client->capabilities.textDocument->diagnostic)
     {
-        auto report = workspace->workspaceDiagnostics(params);
-        fullReport.items.insert(fullReport.items.end(), std::make_move_iterator(report.items.begin()), std::make_move_iterator(report.items.end()));
+        client->publishDiagnostics(lsp::PublishDiagnosticsParams{deferred.uri, textDocument->version(), diagnostics.items});
+        for (const auto& [relatedUri, relatedDiagnostics] : diagnostics.relatedDocuments)
+        {
+            if (relatedDiagnostics.kind == lsp::DocumentDiagnosticReportKind::Full)
+                client->publishDiagnostics(lsp::PublishDiagnosticsParams{Uri::parse(relatedUri), std::nullopt, relatedDiagnostics.items});
+        }
+    }
+    else
+    {
+        // The module has now been checked, so the client pulling diagnostics again will be cheap.
+        // Documents whose diagnostics are unchanged will be reported as such, using their result ids
+        client->refreshWorkspaceDiagnostics();
     }
 
-    client->workspaceDiagnosticsToken = params.partialResultToken;
-    if (params.partialResultToken)
+    return true;
+}
+
+void WorkspaceFolder::applyDiagnosticsResultId(const lsp::DocumentDiagnosticParams& params, lsp::DocumentDiagnosticReport& report)
+{
+    auto key = params.textDocument.uri.toString();
+    auto it = reportedDiagnostics.find(key);
+    if (it != reportedDiagnostics.end() && params.previousResultId == it->second.resultId && json(report.items) == json(it->second.items))
     {
-        // Send the initial report as a partial result, and allow streaming of further results
-        client->sendProgress({params.partialResultToken.value(), fullReport});
-        return std::nullopt;
+        report.kind = lsp::DocumentDiagnosticReportKind::Unchanged;
+        report.resultId = it->second.resultId;
+        report.items.clear();
+        return;
     }
-    else
+
+    auto resultId = std::to_string(++nextDiagnosticsResultId);
+    report.resultId = resultId;
+    reportedDiagnostics.insert_or_assign(key, ReportedDiagnostics{resultId, report.items});
+}
+
+void WorkspaceFolder::saveCaches()
+{
+    if (!diagnosticsCache.isEnabled() && !moduleInterfaceCache.isEnabled())
+        return;
+
+    auto config = client->getConfiguration(rootUri);
+    auto environmentHash = getCacheEnvironmentHash(config);
+    std::unordered_map<Luau::ModuleName, std::optional<std::string>> visited;
+
+    if (moduleInterfaceCache.isEnabled())
     {
-        return fullReport;
+        // Store the interfaces of all modules checked in this session. Stubbed modules keep the entries they were loaded from
+        for (const auto& [moduleName, _] : frontend.sourceNodes)
+        {
+            if (frontend.isDirty(moduleName) || contains(interfaceStubs, moduleName))
+                continue;
+
+            auto module = frontend.moduleResolver.getModule(moduleName);
+            auto source = fileResolver.readSource(moduleName);
+            if (!module || !source)
+                continue;
+
+            auto interfaceHash = hashModuleInterface(serializeModuleInterface(*module));
+            visited.insert_or_assign(moduleName, interfaceHash);
+
+            auto dependencyHash = computeDependencyHash(moduleName, environmentHash, visited);
+            if (!dependencyHash)
+                continue;
+
+            auto entry = CachedModuleInterface{hashString(source->source), *dependencyHash, interfaceHash, createInterfaceStub(*module)};
+            moduleInterfaceCache.store(moduleName, std::move(entry), environmentHash);
+        }
+
+        if (!moduleInterfaceCache.save())
+            client->sendLogMessage(lsp::MessageType::Warning, "Failed to save module interface cache for workspace " + name);
+    }
+
+    if (diagnosticsCache.isEnabled())
+    {
+        auto saved = diagnosticsCache.save(environmentHash,
+            [&](const std::string& moduleName) -> std::optional<ModuleHashes>
+            {
+                // Diagnostics of modules which have since been marked dirty are out of date, and the sources of stubbed modules are not read
+                if (frontend.isDirty(moduleName) || contains(interfaceStubs, moduleName))
+                    return std::nullopt;
+                return computeModuleHashes(moduleName, environmentHash, visited);
+            });
+
+        if (!saved)
+            client->sendLogMessage(lsp::MessageType::Warning, "Failed to save diagnostics cache for workspace " + name);
     }
 }
 
+lsp::DocumentDiagnosticReport LanguageServer::documentDiagnostic(const lsp::DocumentDiagnosticParams& params)
+{
+    auto workspace = findWorkspace(params.textDocument.uri);
+    auto report = workspace->documentDiagnostics(params, /* allowDeferredTypeCheck: */ true);
+    workspace->applyDiagnosticsResultId(params, report);
+    return report;
+}
+
+Resumable<lsp::PartialResponse<lsp::WorkspaceDiagnosticReport>> LanguageServer::workspaceDiagnostic(const lsp::WorkspaceDiagnosticParams& params)
+{
+    std::vector<Resumable<lsp::WorkspaceDiagnosticReport>> reports;
+    reports.reserve(workspaceFolders.size());
+    for (auto& workspace : workspaceFolders)
+        reports.push_back(workspace->resumableWorkspaceDiagnostics(params));
+
+    auto fullReport = sequence(std::move(reports), lsp::WorkspaceDiagnosticReport{},
+        [](lsp::WorkspaceDiagnosticReport& fullReport, lsp::WorkspaceDiagnosticReport&& report)
+        {
+            fullReport.items.insert(
+                fullReport.items.end(), std::make_move_iterator(report.items.begin()), std::make_move_iterator(report.items.end()));
+        });
+
+    return mapResult<lsp::PartialResponse<lsp::WorkspaceDiagnosticReport>>(std::move(fullReport),
+        [this, params](lsp::WorkspaceDiagnosticReport&& fullReport) -> lsp::PartialResponse<lsp::WorkspaceDiagnosticReport>
+        {
+            client->workspaceDiagnosticsToken = params.partialResultToken;
+            if (params.partialResultToken)
+            {
+                // Send the initial report as a partial result, and allow streaming of further results
+                client->sendProgress({params.partialResultToken.value(), fullReport});
+                return std::nullopt;
+            }
+            else
+            {
+                return fullReport;
+            }
+        });
+}
+
 void Client::terminateWorkspaceDiagnostics(bool retriggerRequest)
 {
     lsp::DiagnosticServerCancellationData cancellationData{retriggerRequest};
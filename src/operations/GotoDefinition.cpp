@@ -57,7 +57,7 @@ lsp::DefinitionResult WorkspaceFolder::gotoDefinition(const lsp::DefinitionParam
             }
 
             const auto* symbol = Luau::get<Luau::Symbol>(*current);
-            auto scope = Luau::findScopeAtPosition(*module, position);
+            auto scope = getScopeIndex(module)->findScopeAtPosition(position);
             if (!scope)
                 return result;
 
@@ -114,7 +114,7 @@ lsp::DefinitionResult WorkspaceFolder::gotoDefinition(const lsp::DefinitionParam
         auto uri = params.textDocument.uri;
         TextDocumentPtr referenceTextDocument(textDocument);
 
-        auto scope = Luau::findScopeAtPosition(*module, position);
+        auto scope = getScopeIndex(module)->findScopeAtPosition(position);
         if (!scope)
             return result;
 
@@ -194,7 +194,7 @@ std::optional<lsp::Location> WorkspaceFolder::gotoTypeDefinition(const lsp::Type
             auto uri = params.textDocument.uri;
             TextDocumentPtr referenceTextDocument(textDocument);
 
-            auto scope = Luau::findScopeAtPosition(*module, position);
+            auto scope = getScopeIndex(module)->findScopeAtPosition(position);
             if (!scope)
                 return std::nullopt;
 
@@ -38,7 +38,7 @@ std::optional<lsp::Hover> WorkspaceFolder::hover(const lsp::HoverParams& params)
 
     auto exprOrLocal = Luau::findExprOrLocalAtPosition(*sourceModule, position);
     auto node = findNodeOrTypeAtPosition(*sourceModule, position);
-    auto scope = Luau::findScopeAtPosition(*module, position);
+    auto scope = getScopeIndex(module)->findScopeAtPosition(position);
     if (!node || !scope)
         return std::nullopt;
 
@@ -35,6 +35,8 @@ struct InlayHintVisitor : public Luau::AstVisitor
     const Luau::ModulePtr& module;
     const ClientConfiguration& config;
     const TextDocument* textDocument;
+    // The scope of every local is looked up, so we index the scopes rather than scanning them each time
+    ScopeIndex scopeIndex;
     std::vector<lsp::InlayHint> hints{};
     Luau::ToStringOptions stringOptions;
 
@@ -42,7 +44,7 @@ struct InlayHintVisitor : public Luau::AstVisitor
         : module(module)
         , config(config)
         , textDocument(textDocument)
-
+        , scopeIndex(*module)
     {
         stringOptions.maxTableLength = 30;
         stringOptions.maxTypeLength = config.inlayHints.typeHintMaxLength;
@@ -53,7 +55,7 @@ struct InlayHintVisitor : public Luau::AstVisitor
         if (!config.inlayHints.variableTypes)
             return true;
 
-        auto scope = Luau::findScopeAtPosition(*module, local->location.begin);
+        auto scope = scopeIndex.findScopeAtPosition(local->location.begin);
         if (!scope)
             return false;
 
@@ -104,7 +106,7 @@ struct InlayHintVisitor : public Luau::AstVisitor
         if (!config.inlayHints.variableTypes)
             return true;
 
-        auto scope = Luau::findScopeAtPosition(*module, forIn->location.begin);
+        auto scope = scopeIndex.findScopeAtPosition(forIn->location.begin);
         if (!scope)
             return false;
 
@@ -54,87 +54,98 @@ std::vector<Luau::ModuleName> WorkspaceFolder::findReverseDependencies(const Lua
 }
 
 // Find all references across all files for the usage of TableType, or a property on a TableType
-std::vector<Reference> WorkspaceFolder::findAllReferences(Luau::TypeId ty, std::optional<Luau::Name> property)
+// Each dependent module is searched in a separate unit of work
+Resumable<std::vector<Reference>> WorkspaceFolder::resumableFindAllReferences(Luau::TypeId ty, std::optional<Luau::Name> property)
 {
     ty = Luau::follow(ty);
     auto ttv = Luau::get<Luau::TableType>(ty);
 
     if (!ttv)
-        return {};
+        return ready(std::vector<Reference>{});
 
     if (ttv->definitionModuleName.empty())
-        return {};
+        return ready(std::vector<Reference>{});
 
-    std::vector<Reference> references;
-    std::vector<Luau::ModuleName> dependents = findReverseDependencies(ttv->definitionModuleName);
+    auto definitionModuleName = ttv->definitionModuleName;
+    std::vector<Luau::ModuleName> dependents = findReverseDependencies(definitionModuleName);
 
     // For every module, search for its referencing
-    for (const auto& moduleName : dependents)
-    {
-        // Run the typechecker over the dependency modules
-        checkStrict(moduleName);
-        auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
-        if (!module)
-            continue;
-
-        for (const auto [expr, referencedTy] : module->astTypes)
+    return forEach<std::vector<Reference>>(
+        std::move(dependents), std::vector<Reference>{},
+        [this, ty, property](const Luau::ModuleName& moduleName, std::vector<Reference>& references)
         {
-            // If we are looking for a property specifically,
-            // then only look for LuauAstExprIndexName
-            if (property)
+            // Run the typechecker over the dependency modules
+            checkStrict(moduleName);
+            auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
+            if (!module)
+                return;
+
+            for (const auto [expr, referencedTy] : module->astTypes)
             {
-                if (auto indexName = expr->as<Luau::AstExprIndexName>(); indexName && indexName->index.value == property.value())
+                // If we are looking for a property specifically,
+                // then only look for LuauAstExprIndexName
+                if (property)
                 {
-                    auto possibleParentTy = module->astTypes.find(indexName->expr);
-                    if (possibleParentTy && isSameTable(ty, Luau::follow(*possibleParentTy)))
-                        references.push_back(Reference{moduleName, indexName->indexLocation});
-                }
-                else if (auto table = expr->as<Luau::AstExprTable>(); table && isSameTable(ty, Luau::follow(referencedTy)))
-                {
-                    for (const auto& item : table->items)
+                    if (auto indexName = expr->as<Luau::AstExprIndexName>(); indexName && indexName->index.value == property.value())
+                    {
+                        auto possibleParentTy = module->astTypes.find(indexName->expr);
+                        if (possibleParentTy && isSameTable(ty, Luau::follow(*possibleParentTy)))
+                            references.push_back(Reference{moduleName, indexName->indexLocation});
+                    }
+                    else if (auto table = expr->as<Luau::AstExprTable>(); table && isSameTable(ty, Luau::follow(referencedTy)))
                     {
-                        if (item.key)
+                        for (const auto& item : table->items)
                         {
-                            if (auto propName = item.key->as<Luau::AstExprConstantString>())
+                            if (item.key)
                             {
-                                if (propName->value.data == property.value())
-                                    references.push_back(Reference{moduleName, item.key->location});
+                                if (auto propName = item.key->as<Luau::AstExprConstantString>())
+                                {
+                                    if (propName->value.data == property.value())
+                                        references.push_back(Reference{moduleName, item.key->location});
+                                }
                             }
                         }
                     }
                 }
+                else
+                {
+                    if (isSameTable(ty, Luau::follow(referencedTy)))
+                        references.push_back(Reference{moduleName, expr->location});
+                }
             }
-            else
+        },
+        [ty, property, definitionModuleName](std::vector<Reference>&& references)
+        {
+            // If its a property, include its original declaration location if not yet found
+            if (property)
             {
-                if (isSameTable(ty, Luau::follow(referencedTy)))
-                    references.push_back(Reference{moduleName, expr->location});
+                if (auto prop = lookupProp(ty, *property); prop && prop->location)
+                {
+                    auto reference = Reference{definitionModuleName, prop->location.value()};
+                    if (!contains(references, reference))
+                        references.push_back(reference);
+                }
             }
-        }
-    }
 
-    // If its a property, include its original declaration location if not yet found
-    if (property)
-    {
-        if (auto prop = lookupProp(ty, *property); prop && prop->location)
-        {
-            auto reference = Reference{ttv->definitionModuleName, prop->location.value()};
-            if (!contains(references, reference))
-                references.push_back(reference);
-        }
-    }
+            return std::move(references);
+        });
+}
 
-    return references;
+std::vector<Reference> WorkspaceFolder::findAllReferences(Luau::TypeId ty, std::optional<Luau::Name> property)
+{
+    return runToCompletion(resumableFindAllReferences(ty, property));
 }
 
 // Find all references of an exported type
-std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName)
+// Each dependent module is searched in a separate unit of work
+Resumable<std::vector<Reference>> WorkspaceFolder::resumableFindAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName)
 {
     std::vector<Reference> result;
 
     // Handle the module the type is declared in
     auto sourceModule = frontend.getSourceModule(moduleName);
     if (!sourceModule)
-        return {};
+        return ready(std::vector<Reference>{});
 
     auto references = findTypeReferences(*sourceModule, typeName, std::nullopt);
     result.reserve(references.size() + 1);
@@ -145,7 +156,7 @@ std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::Module
     checkStrict(moduleName);
     auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
     if (!module)
-        return {};
+        return ready(std::vector<Reference>{});
 
     if (auto location = module->getModuleScope()->typeAliasNameLocations.find(typeName);
         location != module->getModuleScope()->typeAliasNameLocations.end())
@@ -153,40 +164,49 @@ std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::Module
 
     // Find all cross-module references
     auto reverseDependencies = findReverseDependencies(moduleName);
-    for (const auto& dependencyModuleName : reverseDependencies)
-    {
-        // Handle the imported module separately
-        if (dependencyModuleName == moduleName)
-            continue;
-
-        // Run the typechecker over the dependency module
-        checkStrict(dependencyModuleName);
-        auto sourceModule = frontend.getSourceModule(dependencyModuleName);
-        auto module = frontend.moduleResolverForAutocomplete.getModule(dependencyModuleName);
-        if (sourceModule)
+    return forEach<std::vector<Reference>>(
+        std::move(reverseDependencies), std::move(result),
+        [this, moduleName, typeName](const Luau::ModuleName& dependencyModuleName, std::vector<Reference>& result)
         {
-            // Find the import name used
-            Luau::Name importName;
-            for (const auto& [name, mod] : module->getModuleScope()->importedModules)
+            // Handle the imported module separately
+            if (dependencyModuleName == moduleName)
+                return;
+
+            // Run the typechecker over the dependency module
+            checkStrict(dependencyModuleName);
+            auto sourceModule = frontend.getSourceModule(dependencyModuleName);
+            auto module = frontend.moduleResolverForAutocomplete.getModule(dependencyModuleName);
+            if (sourceModule && module)
             {
-                if (mod == moduleName)
+                // Find the import name used
+                Luau::Name importName;
+                for (const auto& [name, mod] : module->getModuleScope()->importedModules)
                 {
-                    importName = name;
-                    break;
+                    if (mod == moduleName)
+                    {
+                        importName = name;
+                        break;
+                    }
                 }
-            }
 
-            if (importName.empty())
-                continue;
+                if (importName.empty())
+                    return;
 
-            auto references = findTypeReferences(*sourceModule, typeName, importName);
-            result.reserve(result.size() + references.size());
-            for (auto& location : references)
-                result.emplace_back(Reference{dependencyModuleName, location});
-        }
-    }
+                auto references = findTypeReferences(*sourceModule, typeName, importName);
+                result.reserve(result.size() + references.size());
+                for (auto& location : references)
+                    result.emplace_back(Reference{dependencyModuleName, location});
+            }
+        },
+        [](std::vector<Reference>&& result)
+        {
+            return std::move(result);
+        });
+}
 
-    return result;
+std::vector<Reference> WorkspaceFolder::findAllTypeReferences(const Luau::ModuleName& moduleName, const Luau::Name& typeName)
+{
+    return runToCompletion(resumableFindAllTypeReferences(moduleName, typeName));
 }
 
 static std::vector<lsp::Location> processReferences(WorkspaceFileResolver& fileResolver, const std::vector<Reference>& references)
@@ -217,7 +237,17 @@ static std::vector<lsp::Location> processReferences(WorkspaceFileResolver& fileR
     return result;
 }
 
-lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& params)
+/// Converts the references into locations once they have all been found
+static Resumable<lsp::ReferenceResult> processReferences(WorkspaceFileResolver& fileResolver, Resumable<std::vector<Reference>> references)
+{
+    return mapResult<lsp::ReferenceResult>(std::move(references),
+        [&fileResolver](std::vector<Reference>&& references)
+        {
+            return processReferences(fileResolver, references);
+        });
+}
+
+Resumable<lsp::ReferenceResult> WorkspaceFolder::resumableReferences(const lsp::ReferenceParams& params)
 {
     auto moduleName = fileResolver.getModuleName(params.textDocument.uri);
     auto textDocument = fileResolver.getTextDocument(params.textDocument.uri);
@@ -232,7 +262,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
 
     auto sourceModule = frontend.getSourceModule(moduleName);
     if (!sourceModule)
-        return std::nullopt;
+        return ready<lsp::ReferenceResult>(std::nullopt);
 
     auto exprOrLocal = Luau::findExprOrLocalAtPosition(*sourceModule, position);
     Luau::Symbol localSymbol;
@@ -260,7 +290,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
                 lsp::Location{params.textDocument.uri, {textDocument->convertPosition(location.begin), textDocument->convertPosition(location.end)}});
         }
 
-        return result;
+        return ready<lsp::ReferenceResult>(result);
     }
 
     // Search for a property
@@ -273,8 +303,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
             if (possibleParentTy)
             {
                 auto parentTy = Luau::follow(*possibleParentTy);
-                auto references = findAllReferences(parentTy, indexName->index.value);
-                return processReferences(fileResolver, references);
+                return processReferences(fileResolver, resumableFindAllReferences(parentTy, indexName->index.value));
             }
         }
     }
@@ -282,7 +311,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
     // Search for a type reference
     auto node = findNodeOrTypeAtPosition(*sourceModule, position);
     if (!node)
-        return std::nullopt;
+        return ready<lsp::ReferenceResult>(std::nullopt);
 
     if (auto reference = node->as<Luau::AstTypeReference>())
     {
@@ -291,11 +320,10 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
             if (auto importedModuleName = module->getModuleScope()->importedModules.find(prefix.value().value);
                 importedModuleName != module->getModuleScope()->importedModules.end())
             {
-                auto references = findAllTypeReferences(importedModuleName->second, reference->name.value);
-                return processReferences(fileResolver, references);
+                return processReferences(fileResolver, resumableFindAllTypeReferences(importedModuleName->second, reference->name.value));
             }
 
-            return std::nullopt;
+            return ready<lsp::ReferenceResult>(std::nullopt);
         }
         else
         {
@@ -306,7 +334,7 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
                     params.textDocument.uri, {textDocument->convertPosition(location.begin), textDocument->convertPosition(location.end)}});
 
             // Find the actual declaration location
-            auto scope = Luau::findScopeAtPosition(*module, position);
+            auto scope = getScopeIndex(module)->findScopeAtPosition(position);
             while (scope)
             {
                 if (auto location = scope->typeAliasNameLocations.find(reference->name.value); location != scope->typeAliasNameLocations.end())
@@ -319,15 +347,20 @@ lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& par
                 scope = scope->parent;
             }
 
-            return result;
+            return ready<lsp::ReferenceResult>(result);
         }
     }
 
-    return std::nullopt;
+    return ready<lsp::ReferenceResult>(std::nullopt);
+}
+
+lsp::ReferenceResult WorkspaceFolder::references(const lsp::ReferenceParams& params)
+{
+    return runToCompletion(resumableReferences(params));
 }
 
-lsp::ReferenceResult LanguageServer::references(const lsp::ReferenceParams& params)
+Resumable<lsp::ReferenceResult> LanguageServer::references(const lsp::ReferenceParams& params)
 {
     auto workspace = findWorkspace(params.textDocument.uri);
-    return workspace->references(params);
+    return workspace->resumableReferences(params);
 }
\ No newline at end of file
@@ -170,7 +170,7 @@ lsp::RenameResult WorkspaceFolder::rename(const lsp::RenameParams& params)
                     lsp::TextEdit{{textDocument->convertPosition(location.begin), textDocument->convertPosition(location.end)}, params.newName});
 
             // Find the actual declaration location
-            auto scope = Luau::findScopeAtPosition(*module, position);
+            auto scope = getScopeIndex(module)->findScopeAtPosition(position);
             while (scope)
             {
                 if (auto location = scope->typeAliasNameLocations.find(reference->name.value); location != scope->typeAliasNameLocations.end())
@@ -69,6 +69,8 @@ struct SemanticTokensVisitor : public Luau::AstVisitor
 {
     const Luau::ModulePtr& module;
     const std::unordered_map<Luau::AstName, Luau::TypeId>& builtinGlobals;
+    // The scope of every local is looked up, so we index the scopes rather than scanning them each time
+    ScopeIndex scopeIndex;
     std::vector<SemanticToken> tokens{};
     std::unordered_map<Luau::AstLocal*, AstLocalInfo> localMap{};
     std::unordered_set<Luau::AstType*> syntheticTypes{};
@@ -76,6 +78,7 @@ struct SemanticTokensVisitor : public Luau::AstVisitor
     explicit SemanticTokensVisitor(const Luau::ModulePtr& module, const std::unordered_map<Luau::AstName, Luau::TypeId>& builtinGlobals)
         : module(module)
         , builtinGlobals(builtinGlobals)
+        , scopeIndex(*module)
     {
     }
 
@@ -155,7 +158,7 @@ struct SemanticTokensVisitor : public Luau::AstVisitor
 
     bool visit(Luau::AstStatLocal* local) override
     {
-        auto scope = Luau::findScopeAtPosition(*module, local->location.begin);
+        auto scope = scopeIndex.findScopeAtPosition(local->location.begin);
         if (!scope)
             return true;
 
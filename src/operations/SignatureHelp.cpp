@@ -47,7 +47,7 @@ std::optional<lsp::SignatureHelp> WorkspaceFolder::signatureHelp(const lsp::Sign
 
     auto module = frontend.moduleResolverForAutocomplete.getModule(moduleName);
     auto ancestry = Luau::findAstAncestryOfPosition(*sourceModule, position);
-    auto scope = Luau::findScopeAtPosition(*module, position);
+    auto scope = getScopeIndex(module)->findScopeAtPosition(position);
 
     if (ancestry.size() == 0 || !scope)
         return std::nullopt;
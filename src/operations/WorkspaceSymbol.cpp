@@ -103,35 +103,53 @@ struct WorkspaceSymbolsVisitor : public Luau::AstVisitor
     }
 };
 
-std::optional<std::vector<lsp::WorkspaceSymbol>> WorkspaceFolder::workspaceSymbol(const lsp::WorkspaceSymbolParams& params)
+Resumable<std::vector<lsp::WorkspaceSymbol>> WorkspaceFolder::resumableWorkspaceSymbol(const lsp::WorkspaceSymbolParams& params)
 {
-    std::vector<lsp::WorkspaceSymbol> result;
-
-    for (const auto& [moduleName, sourceModule] : frontend.sourceModules)
-    {
-        frontend.parse(moduleName);
-
-        // Find relevant text document
-        if (auto textDocument = fileResolver.getTextDocumentFromModuleName(moduleName))
-        {
-            WorkspaceSymbolsVisitor visitor{textDocument, params.query};
-            visitor.visit(sourceModule->root);
-            result.insert(result.end(), std::make_move_iterator(visitor.symbols.begin()), std::make_move_iterator(visitor.symbols.end()));
-        }
-        else
+    // Syntax trees released under memory pressure are reparsed whilst searching, so collect the module names up front
+    std::vector<Luau::ModuleName> moduleNames;
+    moduleNames.reserve(frontend.sourceNodes.size());
+    for (const auto& [moduleName, _] : frontend.sourceNodes)
+        moduleNames.push_back(moduleName);
+
+    // Each module is searched in a separate unit of work
+    return forEach<std::vector<lsp::WorkspaceSymbol>>(
+        std::move(moduleNames), std::vector<lsp::WorkspaceSymbol>{},
+        [this, query = params.query](const Luau::ModuleName& moduleName, std::vector<lsp::WorkspaceSymbol>& result)
         {
-            if (auto filePath = fileResolver.resolveToRealPath(moduleName))
+            frontend.parse(moduleName);
+            auto sourceModule = getSourceModule(moduleName);
+            if (!sourceModule || !sourceModule->root)
+                return;
+
+            // Find relevant text document
+            if (auto textDocument = fileResolver.getTextDocumentFromModuleName(moduleName))
             {
-                if (auto source = fileResolver.readSource(moduleName))
+                WorkspaceSymbolsVisitor visitor{textDocument, query};
+                visitor.visit(sourceModule->root);
+                result.insert(result.end(), std::make_move_iterator(visitor.symbols.begin()), std::make_move_iterator(visitor.symbols.end()));
+            }
+            else
+            {
+                if (auto filePath = fileResolver.resolveToRealPath(moduleName))
                 {
-                    auto textDocument = TextDocument{Uri::file(*filePath), "luau", 0, source->source};
-                    WorkspaceSymbolsVisitor visitor{&textDocument, params.query};
-                    visitor.visit(sourceModule->root);
-                    result.insert(result.end(), std::make_move_iterator(visitor.symbols.begin()), std::make_move_iterator(visitor.symbols.end()));
+                    if (auto source = fileResolver.readSource(moduleName))
+                    {
+                        auto textDocument = TextDocument{Uri::file(*filePath), "luau", 0, source->source};
+                        WorkspaceSymbolsVisitor visitor{&textDocument, query};
+                        visitor.visit(sourceModule->root);
+                        result.insert(
+                            result.end(), std::make_move_iterator(visitor.symbols.begin()), std::make_move_iterator(visitor.symbols.end()));
+                    }
                 }
             }
-        }
-    }
+        },
+        [](std::vector<lsp::WorkspaceSymbol>&& result)
+        {
+            return std::move(result);
+        });
+}
 
-    return result;
-}
\ No newline at end of file
+std::optional<std::vector<lsp::WorkspaceSymbol>> WorkspaceFolder::workspaceSymbol(const lsp::WorkspaceSymbolParams& params)
+{
+    return runToCompletion(resumableWorkspaceSymbol(params));
+}
@@ -1,6 +1,8 @@
 #include "doctest.h"
 #include "Fixture.h"
 
+#include <fstream>
+
 TEST_SUITE_BEGIN("Diagnostics");
 
 TEST_CASE_FIXTURE(Fixture, "instance_is_a")
@@ -70,4 +72,71 @@ TEST_CASE_FIXTURE(Fixture, "enum_is_a_unknown_enum")
     CHECK(toString(result.errors[0]) == "Unknown type 'unknown'");
 }
 
-TEST_SUITE_END();
\ No newline at end of file
+TEST_CASE_FIXTURE(Fixture, "syntax_first_diagnostics_only_carry_over_type_errors_before_an_edit")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    // Documents are opened at real paths, so that they can be required relative to each other
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-syntax-first";
+    auto dependencyUri = Uri::file(root / "Dependency.luau");
+    auto uri = Uri::file(root / "Module.luau");
+    workspace.openTextDocument(dependencyUri, {{dependencyUri, "luau", 0, "return 1"}});
+    workspace.openTextDocument(
+        uri, {{uri, "luau", 0, "--!strict\nlocal x: string = 1\nlocal D = require(\"./Dependency.luau\")\nlocal y: string = 2\n"}});
+
+    lsp::DocumentDiagnosticParams params{{uri}};
+    REQUIRE_EQ(workspace.documentDiagnostics(params).items.size(), 2);
+
+    // Editing the dependency leaves it unchecked, so the module is served syntax-only diagnostics
+    lsp::DidChangeTextDocumentParams dependencyChange;
+    dependencyChange.textDocument.uri = dependencyUri;
+    dependencyChange.textDocument.version = 1;
+    dependencyChange.contentChanges.push_back({std::nullopt, "return 2"});
+    workspace.updateTextDocument(dependencyUri, dependencyChange);
+
+    // Inserting a line moves the second type error, so it can no longer be carried over
+    lsp::DidChangeTextDocumentParams change;
+    change.textDocument.uri = uri;
+    change.textDocument.version = 1;
+    change.contentChanges.push_back({lsp::Range{{2, 0}, {2, 0}}, "\n"});
+    workspace.updateTextDocument(uri, change);
+
+    auto diagnostics = workspace.documentDiagnostics(params, /* allowDeferredTypeCheck: */ true);
+    REQUIRE_EQ(diagnostics.items.size(), 1);
+    CHECK_EQ(diagnostics.items[0].range.start.line, 1);
+}
+
+TEST_CASE_FIXTURE(Fixture, "workspace_diagnostics_clear_files_within_newly_ignored_directories")
+{
+    client->globalConfig.diagnostics.workspace = true;
+
+    std::error_code ec;
+    auto root = std::filesystem::weakly_canonical(std::filesystem::temp_directory_path(), ec) / "luau-lsp-ignored-directories";
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root / "src" / "Generated");
+    std::ofstream(root / "src" / "Generated" / "Module.luau") << "--!strict\nlocal x: number = \"string\"\n";
+    auto uri = Uri::file(root / "src" / "Generated" / "Module.luau");
+
+    WorkspaceFolder folder(client, "luau-lsp-ignored-directories", Uri::file(root), std::nullopt);
+    folder.initialize();
+
+    auto report = folder.workspaceDiagnostics({});
+    REQUIRE_EQ(report.items.size(), 1);
+    CHECK_EQ(report.items[0].uri, uri);
+    CHECK_FALSE(report.items[0].items.empty());
+
+    // The directory is no longer walked, but the diagnostics previously reported for its files are cleared
+    client->globalConfig.ignoreGlobs = {"**/Generated/**"};
+    report = folder.workspaceDiagnostics({});
+    REQUIRE_EQ(report.items.size(), 1);
+    CHECK_EQ(report.items[0].uri, uri);
+    CHECK(report.items[0].items.empty());
+
+    // Once cleared, the file is not reported again
+    report = folder.workspaceDiagnostics({});
+    CHECK(report.items.empty());
+
+    std::filesystem::remove_all(root, ec);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,88 @@
+#include "doctest.h"
+#include "LSP/DiagnosticsCache.hpp"
+
+TEST_SUITE_BEGIN("DiagnosticsCache");
+
+static std::filesystem::path getCachePath()
+{
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-diagnostics-cache-test" / "diagnostics.json";
+    std::filesystem::remove_all(path.parent_path());
+    return path;
+}
+
+static std::vector<lsp::Diagnostic> createDiagnostics(const std::string& message)
+{
+    lsp::Diagnostic diagnostic;
+    diagnostic.range = {{0, 0}, {0, 5}};
+    diagnostic.severity = lsp::DiagnosticSeverity::Warning;
+    diagnostic.message = message;
+    return {diagnostic};
+}
+
+TEST_CASE("cached diagnostics are restored in the next session")
+{
+    auto path = getCachePath();
+
+    DiagnosticsCache cache;
+    cache.load(path);
+    cache.record("Module", createDiagnostics("unknown global"));
+    CHECK(cache.save("environment",
+        [](const std::string&)
+        {
+            return ModuleHashes{"content", "dependencies"};
+        }));
+
+    DiagnosticsCache nextSession;
+    nextSession.load(path);
+    auto entry = nextSession.take("Module", "environment");
+    REQUIRE(entry);
+    CHECK_EQ(entry->contentHash, "content");
+    CHECK_EQ(entry->dependencyHash, "dependencies");
+    REQUIRE_EQ(entry->diagnostics.size(), 1);
+    CHECK_EQ(entry->diagnostics[0].message, "unknown global");
+
+    // Entries are only served once
+    CHECK_FALSE(nextSession.take("Module", "environment"));
+}
+
+TEST_CASE("cached diagnostics are discarded if the environment has changed")
+{
+    auto path = getCachePath();
+
+    DiagnosticsCache cache;
+    cache.load(path);
+    cache.record("Module", createDiagnostics("unknown global"));
+    cache.save("environment",
+        [](const std::string&)
+        {
+            return ModuleHashes{"content", "dependencies"};
+        });
+
+    DiagnosticsCache nextSession;
+    nextSession.load(path);
+    CHECK_FALSE(nextSession.take("Module", "changed environment"));
+}
+
+TEST_CASE("out of date diagnostics are not persisted")
+{
+    auto path = getCachePath();
+
+    DiagnosticsCache cache;
+    cache.load(path);
+    cache.record("Module", createDiagnostics("unknown global"));
+    cache.record("Dirty", createDiagnostics("type mismatch"));
+    cache.save("environment",
+        [](const std::string& moduleName) -> std::optional<ModuleHashes>
+        {
+            if (moduleName == "Dirty")
+                return std::nullopt;
+            return ModuleHashes{"content", "dependencies"};
+        });
+
+    DiagnosticsCache nextSession;
+    nextSession.load(path);
+    CHECK(nextSession.take("Module", "environment"));
+    CHECK_FALSE(nextSession.take("Dirty", "environment"));
+}
+
+TEST_SUITE_END();
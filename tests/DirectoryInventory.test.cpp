@@ -0,0 +1,141 @@
+#include "doctest.h"
+#include "Fixture.h"
+#include "LSP/DirectoryInventory.hpp"
+#include "LSP/LanguageServer.hpp"
+
+#include <fstream>
+
+TEST_SUITE_BEGIN("DirectoryInventory");
+
+static std::filesystem::path createWorkspace()
+{
+    std::error_code ec;
+    auto root = std::filesystem::weakly_canonical(std::filesystem::temp_directory_path(), ec) / "luau-lsp-directory-inventory-test";
+    std::filesystem::remove_all(root);
+
+    for (const auto& path : {"src/init.luau", "src/Module.lua", "src/README.md", "src/Components/Button.luau"})
+    {
+        std::filesystem::create_directories((root / path).parent_path());
+        std::ofstream(root / path) << "";
+    }
+
+    return root;
+}
+
+using Entries = std::vector<DirectoryInventory::Entry>;
+
+TEST_CASE("directories list their subdirectories and source files")
+{
+    auto root = createWorkspace();
+    DirectoryInventory inventory;
+
+    auto entries = inventory.list(root / "src");
+    REQUIRE(entries);
+    CHECK_EQ(*entries, Entries{{"Components", true}, {"Module.lua", false}, {"init.luau", false}});
+
+    CHECK_FALSE(inventory.list(root / "missing"));
+    CHECK_FALSE(inventory.list(root / "src" / "init.luau"));
+}
+
+TEST_CASE("listing a missing directory does not add it to its parent")
+{
+    auto root = createWorkspace();
+    DirectoryInventory inventory;
+
+    REQUIRE(inventory.list(root / "src"));
+    CHECK_FALSE(inventory.list(root / "src" / "missing"));
+    CHECK_FALSE(inventory.list(root / "src" / "missing" / "nested"));
+    CHECK_EQ(*inventory.list(root / "src"), Entries{{"Components", true}, {"Module.lua", false}, {"init.luau", false}});
+
+    // Once the directory exists, it is read when it is next listed
+    std::filesystem::create_directories(root / "src" / "missing");
+    std::ofstream(root / "src" / "missing" / "Found.luau") << "";
+    CHECK_EQ(*inventory.list(root / "src" / "missing"), Entries{{"Found.luau", false}});
+}
+
+TEST_CASE("reading a directory does not keep its listing")
+{
+    auto root = createWorkspace();
+
+    CHECK_EQ(*DirectoryInventory::read(root / "src" / "Components"), Entries{{"Button.luau", false}});
+    CHECK_FALSE(DirectoryInventory::read(root / "missing"));
+
+    std::ofstream(root / "src" / "Components" / "Label.luau") << "";
+    CHECK_EQ(*DirectoryInventory::read(root / "src" / "Components"), Entries{{"Button.luau", false}, {"Label.luau", false}});
+}
+
+TEST_CASE("a directory is only read from disk the first time it is listed")
+{
+    auto root = createWorkspace();
+    DirectoryInventory inventory;
+
+    REQUIRE(inventory.list(root / "src"));
+    REQUIRE(inventory.list(root / "src" / "Components"));
+    CHECK_EQ(inventory.directoryReadCount, 2);
+
+    // Changes which were not reported are not seen until the inventory is cleared
+    std::ofstream(root / "src" / "Other.luau") << "";
+    CHECK_EQ(inventory.list(root / "src")->size(), 3);
+    CHECK_EQ(inventory.list(root / "src" / "Components" / ".." / "")->size(), 3);
+    CHECK_EQ(inventory.directoryReadCount, 2);
+
+    inventory.clear();
+    CHECK_EQ(inventory.list(root / "src")->size(), 4);
+    CHECK_EQ(inventory.directoryReadCount, 3);
+}
+
+TEST_CASE("created files are added to listed directories along with their new ancestors")
+{
+    auto root = createWorkspace();
+    DirectoryInventory inventory;
+    REQUIRE(inventory.list(root / "src"));
+
+    inventory.created(root / "src" / "Other.luau", false);
+    inventory.created(root / "src" / "notes.txt", false);
+    inventory.created(root / "src" / "Services" / "Data" / "Store.luau", false);
+
+    CHECK_EQ(*inventory.list(root / "src"),
+        Entries{{"Components", true}, {"Module.lua", false}, {"Other.luau", false}, {"Services", true}, {"init.luau", false}});
+    CHECK_EQ(*inventory.list(root / "src" / "Services" / "Data"), Entries{{"Store.luau", false}});
+    CHECK_EQ(inventory.directoryReadCount, 1);
+}
+
+TEST_CASE("deleted files and directories are removed")
+{
+    auto root = createWorkspace();
+    DirectoryInventory inventory;
+    REQUIRE(inventory.list(root / "src"));
+    REQUIRE(inventory.list(root / "src" / "Components"));
+
+    inventory.deleted(root / "src" / "Module.lua");
+    inventory.deleted(root / "src" / "Components");
+    CHECK_EQ(*inventory.list(root / "src"), Entries{{"init.luau", false}});
+
+    // Deleting something never listed does nothing
+    inventory.deleted(root / "elsewhere" / "File.luau");
+    CHECK_EQ(inventory.directoryReadCount, 2);
+}
+
+TEST_CASE("folders created or deleted by the client update the workspace's listings")
+{
+    auto root = createWorkspace();
+    CapturedOutput captured;
+    LanguageServer server({}, {}, std::nullopt);
+    server.onRequest(1, "initialize", json{{"capabilities", json::object()}, {"rootUri", Uri::file(root)}});
+    server.onNotification("initialized", json::object());
+
+    auto& inventory = server.findWorkspace(Uri::file(root / "src"))->directoryInventory;
+    REQUIRE(inventory.list(root / "src"));
+
+    // The file watcher does not report folders, so these are the only events the server receives
+    std::filesystem::remove_all(root / "src" / "Components");
+    std::filesystem::create_directories(root / "src" / "Hooks");
+    server.onNotification("workspace/didDeleteFiles", json{{"files", {{{"uri", Uri::file(root / "src" / "Components")}}}}});
+    server.onNotification("workspace/didCreateFiles", json{{"files", {{{"uri", Uri::file(root / "src" / "Hooks")}}}}});
+
+    auto entries = inventory.list(root / "src");
+    REQUIRE(entries);
+    CHECK_EQ(*entries, Entries{{"Hooks", true}, {"Module.lua", false}, {"init.luau", false}});
+}
+
+TEST_SUITE_END();
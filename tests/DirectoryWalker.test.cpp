@@ -0,0 +1,98 @@
+#include "doctest.h"
+#include "LSP/DirectoryWalker.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+TEST_SUITE_BEGIN("DirectoryWalker");
+
+static std::filesystem::path createWorkspace()
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-directory-walker-test";
+    std::filesystem::remove_all(root);
+
+    for (const auto& path : {"src/init.lua", "src/Module.luau", "src/generated.lua", "build/out.lua", "node_modules/pkg/index.lua",
+             "Packages/_Index/pkg/init.lua", "src/README.md"})
+    {
+        std::filesystem::create_directories((root / path).parent_path());
+        std::ofstream(root / path) << "";
+    }
+
+    std::ofstream(root / ".gitignore") << "# build output\n/build\nnode_modules/\ngenerated.lua\n";
+    return root;
+}
+
+TEST_CASE("gitignore rules are converted into root-relative globs")
+{
+    auto root = createWorkspace();
+
+    std::vector<std::string> expected{"build", "node_modules", "**/node_modules", "generated.lua", "**/generated.lua"};
+    CHECK_EQ(readGitignoreGlobs(root), expected);
+}
+
+TEST_CASE("gitignore rules are not used if any rule is negated")
+{
+    auto root = createWorkspace();
+    std::ofstream(root / ".gitignore", std::ios::app) << "!build/keep.lua\n";
+
+    CHECK(readGitignoreGlobs(root).empty());
+}
+
+TEST_CASE("walker skips ignored and gitignored directories")
+{
+    auto root = createWorkspace();
+    DirectoryWalkRules rules{root, GlobSet({"**/_Index/**"}), GlobSet(readGitignoreGlobs(root))};
+
+    std::vector<std::string> files;
+    walkSourceFiles(root, rules,
+        [&](const std::filesystem::path& path)
+        {
+            files.push_back(path.lexically_relative(root).generic_string());
+            return true;
+        });
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> expected{"src/Module.luau", "src/init.lua"};
+    CHECK_EQ(files, expected);
+}
+
+TEST_CASE("gitignore globs are matched relative to the gitignore root")
+{
+    auto root = createWorkspace();
+    std::filesystem::create_directories(root / "nested" / "out");
+    std::ofstream(root / "nested" / "init.lua") << "";
+    std::ofstream(root / "nested" / "out" / "build.lua") << "";
+    std::ofstream(root / "nested" / ".gitignore") << "/out\n";
+
+    // Ignore globs are matched relative to the root, whilst the nested `.gitignore` applies to the nested directory
+    auto nested = root / "nested";
+    DirectoryWalkRules rules{root, GlobSet(), GlobSet(readGitignoreGlobs(nested)), nested};
+
+    std::vector<std::string> files;
+    walkSourceFiles(nested, rules,
+        [&](const std::filesystem::path& path)
+        {
+            files.push_back(path.lexically_relative(root).generic_string());
+            return true;
+        });
+
+    std::vector<std::string> expected{"nested/init.lua"};
+    CHECK_EQ(files, expected);
+}
+
+TEST_CASE("walker stops when the callback returns false")
+{
+    auto root = createWorkspace();
+
+    size_t count = 0;
+    walkSourceFiles(root, DirectoryWalkRules{root},
+        [&](const std::filesystem::path&)
+        {
+            count += 1;
+            return false;
+        });
+
+    CHECK_EQ(count, 1);
+}
+
+TEST_SUITE_END();
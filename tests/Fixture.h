@@ -16,6 +16,7 @@
 #include "LSP/Workspace.hpp"
 
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
@@ -47,3 +48,20 @@ struct Fixture
 
     std::vector<std::string> getComments(const Luau::Location& node);
 };
+
+/// Captures the messages the server sends to the client for the lifetime of this object, rather than writing them to stdout
+struct CapturedOutput
+{
+    std::ostringstream output;
+    std::streambuf* previous;
+
+    CapturedOutput()
+        : previous(std::cout.rdbuf(output.rdbuf()))
+    {
+    }
+
+    ~CapturedOutput()
+    {
+        std::cout.rdbuf(previous);
+    }
+};
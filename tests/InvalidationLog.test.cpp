@@ -0,0 +1,75 @@
+#include "doctest.h"
+#include "LSP/InvalidationLog.hpp"
+
+TEST_SUITE_BEGIN("InvalidationLog");
+
+TEST_CASE("an invalidation is recorded against every module it invalidated")
+{
+    InvalidationLog log;
+    log.record(InvalidationCause::DocumentChanged, "A", {"A", "B", "C"});
+
+    for (const auto& moduleName : {"A", "B", "C"})
+    {
+        auto invalidation = log.latest(moduleName);
+        REQUIRE(invalidation);
+        CHECK_EQ(invalidation->cause, InvalidationCause::DocumentChanged);
+        CHECK_EQ(invalidation->root, "A");
+        CHECK_EQ(invalidation->moduleCount, 3);
+    }
+
+    CHECK_FALSE(log.latest("D"));
+    CHECK_EQ(log.recent().size(), 1);
+}
+
+TEST_CASE("nothing is recorded when no modules were invalidated")
+{
+    InvalidationLog log;
+    log.record(InvalidationCause::FileChanged, "A", {});
+
+    CHECK_FALSE(log.latest("A"));
+    CHECK(log.recent().empty());
+}
+
+TEST_CASE("workspace invalidations apply to every module in order")
+{
+    InvalidationLog log;
+    log.record(InvalidationCause::DocumentOpened, "A", {"A"});
+    log.recordWorkspace(InvalidationCause::SourcemapChanged);
+    log.record(InvalidationCause::DocumentChanged, "B", {"B"});
+
+    auto invalidations = log.forModule("A");
+    REQUIRE_EQ(invalidations.size(), 2);
+    CHECK_EQ(invalidations[0].cause, InvalidationCause::DocumentOpened);
+    CHECK_EQ(invalidations[1].cause, InvalidationCause::SourcemapChanged);
+
+    CHECK_EQ(log.latest("A")->cause, InvalidationCause::SourcemapChanged);
+    CHECK_EQ(log.latest("B")->cause, InvalidationCause::DocumentChanged);
+    CHECK_EQ(log.latest("C")->cause, InvalidationCause::SourcemapChanged);
+}
+
+TEST_CASE("only the most recent invalidations of a module are kept")
+{
+    InvalidationLog log;
+    for (size_t i = 0; i < InvalidationLog::MAX_RECORDS_PER_MODULE + 2; i++)
+        log.record(InvalidationCause::DocumentChanged, "A", {"A"});
+
+    auto invalidations = log.forModule("A");
+    REQUIRE_EQ(invalidations.size(), InvalidationLog::MAX_RECORDS_PER_MODULE);
+    CHECK_EQ(invalidations.front().sequence, 3);
+    CHECK_EQ(invalidations.back().sequence, InvalidationLog::MAX_RECORDS_PER_MODULE + 2);
+}
+
+TEST_CASE("checked modules are described with the cause of their latest invalidation")
+{
+    InvalidationLog log;
+    CHECK_EQ(describeCheckedModule(log, "A"), "A");
+
+    log.record(InvalidationCause::DocumentChanged, "A", {"A", "B"});
+    CHECK_EQ(describeCheckedModule(log, "A"), "A (document changed)");
+    CHECK_EQ(describeCheckedModule(log, "B"), "B (document changed in A)");
+
+    log.recordWorkspace(InvalidationCause::ConfigurationChanged);
+    CHECK_EQ(describeCheckedModule(log, "B"), "B (configuration changed)");
+}
+
+TEST_SUITE_END();
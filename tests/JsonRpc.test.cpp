@@ -0,0 +1,39 @@
+#include "doctest.h"
+#include "LSP/JsonRpc.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+TEST_SUITE_BEGIN("JsonRpc");
+
+static std::string frame(const std::string& content)
+{
+    return "Content-Length: " + std::to_string(content.size()) + "\r\n\r\n" + content;
+}
+
+TEST_CASE("a message sent in the same write as the previous one is buffered once the previous message is read")
+{
+    std::string first = R"({"jsonrpc":"2.0","method":"initialized","params":{}})";
+    std::string second = R"({"jsonrpc":"2.0","id":1,"method":"textDocument/hover","params":{}})";
+
+    // The client writes both messages at once, as the standard input would receive them
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-json-rpc-messages";
+    std::ofstream(path, std::ios::binary) << frame(first) + frame(second);
+
+    // A file buffer reads ahead like the standard input does once it is no longer synchronised with C stdio
+    std::ifstream input(path, std::ios::binary);
+    std::string message;
+
+    REQUIRE(json_rpc::readRawMessage(input, message));
+    CHECK_EQ(message, first);
+    CHECK(json_rpc::hasBufferedInput(input));
+
+    REQUIRE(json_rpc::readRawMessage(input, message));
+    CHECK_EQ(message, second);
+    CHECK_FALSE(json_rpc::hasBufferedInput(input));
+
+    input.close();
+    std::filesystem::remove(path);
+}
+
+TEST_SUITE_END();
@@ -83,4 +83,118 @@ TEST_CASE_FIXTURE(Fixture, "FindImports require multiline")
     CHECK_EQ(visitor.requiresMap[0].begin()->second->location.end.line, 2);
 }
 
+TEST_CASE_FIXTURE(Fixture, "Service children are only attached once the service is referenced")
+{
+    loadDefinition(R"(
+        declare class ServiceProvider extends Instance end
+        declare class DataModel extends ServiceProvider end
+        declare class ReplicatedStorage extends Instance end
+        declare class ServerStorage extends Instance end
+    )");
+
+    workspace.fileResolver.updateSourceMap(R"({
+        "name": "Game",
+        "className": "DataModel",
+        "children": [
+            {"name": "ReplicatedStorage", "className": "ReplicatedStorage", "children": [{"name": "Shared", "className": "Folder"}]},
+            {"name": "ServerStorage", "className": "ServerStorage", "children": [{"name": "Assets", "className": "Folder"}]}
+        ]
+    })");
+    types::registerInstanceTypes(workspace.frontend, workspace.frontend.globals, workspace.instanceTypes, workspace.fileResolver,
+        workspace.deferredInstanceChildren, /* expressiveTypes: */ true);
+
+    auto replicatedStorage = Luau::get<Luau::ClassType>(workspace.frontend.globals.globalScope->lookupType("ReplicatedStorage")->type);
+    auto serverStorage = Luau::get<Luau::ClassType>(workspace.frontend.globals.globalScope->lookupType("ServerStorage")->type);
+    REQUIRE(replicatedStorage);
+    REQUIRE(serverStorage);
+
+    CHECK_EQ(replicatedStorage->props.count("Shared"), 0);
+    CHECK_EQ(serverStorage->props.count("Assets"), 0);
+
+    check(R"(
+        local function getShared(service: ReplicatedStorage)
+            return service.Shared
+        end
+    )");
+
+    CHECK_EQ(replicatedStorage->props.count("Shared"), 1);
+    CHECK_EQ(serverStorage->props.count("Assets"), 0);
+}
+
+TEST_CASE_FIXTURE(Fixture, "Sourcemap leaf instances of the same class share a type")
+{
+    loadDefinition(R"(
+        declare class ServiceProvider extends Instance end
+        declare class DataModel extends ServiceProvider end
+        declare class ReplicatedStorage extends Instance end
+        declare class Folder extends Instance end
+    )");
+
+    workspace.fileResolver.updateSourceMap(R"({
+        "name": "Game",
+        "className": "DataModel",
+        "children": [
+            {
+                "name": "ReplicatedStorage",
+                "className": "ReplicatedStorage",
+                "children": [
+                    {"name": "A", "className": "Folder"},
+                    {"name": "B", "className": "Folder"},
+                    {"name": "C", "className": "Part"},
+                    {"name": "D", "className": "Folder", "children": [{"name": "E", "className": "Folder"}]}
+                ]
+            }
+        ]
+    })");
+    types::registerInstanceTypes(workspace.frontend, workspace.frontend.globals, workspace.instanceTypes, workspace.fileResolver,
+        workspace.deferredInstanceChildren, /* expressiveTypes: */ true);
+
+    auto dataModel = Luau::get<Luau::ClassType>(workspace.frontend.globals.globalScope->lookupType("DataModel")->type);
+    REQUIRE(dataModel);
+    auto replicatedStorage = Luau::get<Luau::ClassType>(Luau::follow(dataModel->props.at("ReplicatedStorage").type()));
+    REQUIRE(replicatedStorage);
+
+    CHECK_EQ(replicatedStorage->props.at("A").type(), replicatedStorage->props.at("B").type());
+    CHECK_NE(replicatedStorage->props.at("A").type(), replicatedStorage->props.at("C").type());
+    CHECK_NE(replicatedStorage->props.at("A").type(), replicatedStorage->props.at("D").type());
+}
+
+TEST_CASE_FIXTURE(Fixture, "scope index finds the same scopes as findScopeAtPosition")
+{
+    check(R"(
+        local function outer(a: number)
+            local b = a
+            for i = 1, 10 do
+                local c = i
+                if c > 5 then
+                    local d = c
+                end
+            end
+            while true do
+                local e = b
+            end
+            return function()
+                local f = a
+            end
+        end
+        local g = outer
+    )");
+
+    auto module = getMainModule();
+    REQUIRE(module);
+    REQUIRE_FALSE(module->scopes.empty());
+
+    ScopeIndex index{*module};
+    CHECK_EQ(index.size(), module->scopes.size());
+
+    for (unsigned int line = 0; line <= 18; line++)
+    {
+        for (unsigned int column = 0; column <= 40; column++)
+        {
+            Luau::Position position{line, column};
+            CHECK_EQ(index.findScopeAtPosition(position), Luau::findScopeAtPosition(*module, position));
+        }
+    }
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "doctest.h"
+#include "Fixture.h"
+#include "LSP/MemoryGovernor.hpp"
+
+#include <fstream>
+
+TEST_SUITE_BEGIN("MemoryGovernor");
+
+TEST_CASE("caches are only released once memory usage approaches the budget")
+{
+    MemoryGovernor governor;
+    CHECK_EQ(governor.bytesToRelease(800, 500), 0);
+
+    governor.setConfiguredBudget(1000);
+    CHECK_EQ(governor.bytesToRelease(800, 500), 0);
+    CHECK_EQ(governor.bytesToRelease(900, 500), 200);
+
+    // We can release no more than the caches hold
+    CHECK_EQ(governor.bytesToRelease(900, 100), 100);
+}
+
+TEST_CASE("caches are not released again until they have grown")
+{
+    MemoryGovernor governor;
+    governor.setConfiguredBudget(1000);
+
+    CHECK_EQ(governor.bytesToRelease(950, 400), 250);
+    governor.recordRelease(150);
+
+    CHECK_EQ(governor.bytesToRelease(950, 150), 0);
+    CHECK_EQ(governor.bytesToRelease(950, 300), 250);
+
+    // Once usage drops back below the threshold, the caches may be released again
+    CHECK_EQ(governor.bytesToRelease(500, 100), 0);
+    CHECK_EQ(governor.bytesToRelease(950, 100), 100);
+}
+
+TEST_CASE("the memory limit is read from the cgroup")
+{
+    auto root = std::filesystem::temp_directory_path() / "luau-lsp-memory-governor-cgroup";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "memory");
+
+    CHECK_FALSE(MemoryGovernor::readCgroupLimit(root));
+
+    // cgroup v1 represents an unlimited memory limit as a very large value
+    std::ofstream(root / "memory" / "memory.limit_in_bytes") << "9223372036854771712\n";
+    CHECK_FALSE(MemoryGovernor::readCgroupLimit(root));
+    std::ofstream(root / "memory" / "memory.limit_in_bytes") << "536870912\n";
+    CHECK_EQ(MemoryGovernor::readCgroupLimit(root), 536870912);
+
+    // cgroup v2 takes priority
+    std::ofstream(root / "memory.max") << "max\n";
+    CHECK_FALSE(MemoryGovernor::readCgroupLimit(root));
+    std::ofstream(root / "memory.max") << "1073741824\n";
+    CHECK_EQ(MemoryGovernor::readCgroupLimit(root), 1073741824);
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE_FIXTURE(Fixture, "released syntax trees of closed modules are reparsed on demand")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    std::error_code ec;
+    auto root = std::filesystem::weakly_canonical(std::filesystem::temp_directory_path(), ec) / "luau-lsp-memory-governor";
+    std::filesystem::create_directories(root);
+    std::ofstream(root / "A.luau") << "--- Adds one to the number\nlocal function addOne(x: number)\n    return x + 1\nend\nreturn { addOne = addOne }\n";
+
+    auto uri = Uri::file(root / "B.luau");
+    workspace.openTextDocument(uri, {{uri, "luau", 0, "local A = require(\"./A.luau\")\nreturn A.addOne(1)\n"}});
+
+    lsp::DocumentDiagnosticParams params;
+    params.textDocument.uri = uri;
+    workspace.documentDiagnostics(params);
+
+    auto dependency = workspace.fileResolver.getModuleName(Uri::file(root / "A.luau"));
+    REQUIRE(workspace.frontend.getSourceModule(dependency));
+    CHECK_GT(workspace.estimateCacheUsage().typeGraphs, 0);
+
+    // Syntax trees are only released once their type graphs have been
+    CHECK_EQ(workspace.releaseCache(CacheKind::SyntaxTrees), 0);
+    CHECK_GT(workspace.releaseCache(CacheKind::TypeGraphs), 0);
+    CHECK_GT(workspace.releaseCache(CacheKind::SyntaxTrees), 0);
+    CHECK_EQ(workspace.frontend.getSourceModule(dependency), nullptr);
+
+    // Open documents are never released
+    CHECK(workspace.frontend.getSourceModule(workspace.fileResolver.getModuleName(uri)));
+
+    auto sourceModule = workspace.getSourceModule(dependency);
+    REQUIRE(sourceModule);
+    REQUIRE(sourceModule->root);
+    CHECK_EQ(sourceModule->root->body.size, 2);
+    CHECK_FALSE(workspace.frontend.isDirty(dependency));
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE_FIXTURE(Fixture, "type graphs of modules required by open documents are not compacted")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    std::error_code ec;
+    auto root = std::filesystem::weakly_canonical(std::filesystem::temp_directory_path(), ec) / "luau-lsp-compact-type-graphs";
+    std::filesystem::create_directories(root);
+    std::ofstream(root / "Required.luau") << "return { value = 1 }\n";
+    std::ofstream(root / "Unrelated.luau") << "return { value = 2 }\n";
+
+    auto uri = Uri::file(root / "Open.luau");
+    workspace.openTextDocument(uri, {{uri, "luau", 0, "local Required = require(\"./Required.luau\")\nreturn Required.value\n"}});
+
+    lsp::DocumentDiagnosticParams params;
+    params.textDocument.uri = uri;
+    workspace.documentDiagnostics(params);
+    params.textDocument.uri = Uri::file(root / "Unrelated.luau");
+    workspace.documentDiagnostics(params);
+
+    // Only the closed module which no open document requires is compacted
+    CHECK_EQ(workspace.compactTypeGraphs(), 1);
+
+    auto required = workspace.frontend.moduleResolver.getModule(workspace.fileResolver.getModuleName(Uri::file(root / "Required.luau")));
+    REQUIRE(required);
+    CHECK_FALSE(required->internalTypes.types.empty());
+
+    auto unrelated = workspace.frontend.moduleResolver.getModule(workspace.fileResolver.getModuleName(Uri::file(root / "Unrelated.luau")));
+    REQUIRE(unrelated);
+    CHECK(unrelated->internalTypes.types.empty());
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_SUITE_END();
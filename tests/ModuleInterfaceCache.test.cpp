@@ -0,0 +1,99 @@
+#include "doctest.h"
+#include "Fixture.h"
+#include "LSP/ModuleInterfaceCache.hpp"
+#include "Luau/ToString.h"
+
+TEST_SUITE_BEGIN("ModuleInterfaceCache");
+
+TEST_CASE_FIXTURE(Fixture, "serialized interface contains exported types and the return type")
+{
+    check(R"(
+        export type Point = { x: number, y: number }
+        type Private = string
+
+        return {
+            origin = function(): Point
+                return { x = 0, y = 0 }
+            end,
+        }
+    )");
+
+    auto exports = serializeModuleInterface(*getMainModule());
+    REQUIRE_EQ(exports.size(), 2);
+    CHECK(exports[0].find("export type Point = ") == 0);
+    CHECK(exports[0].find("x: number") != std::string::npos);
+    CHECK(exports[1].find("return ") == 0);
+    CHECK(exports[1].find("origin") != std::string::npos);
+}
+
+TEST_CASE_FIXTURE(Fixture, "interface hash is unaffected by changes to the module body")
+{
+    check(R"(
+        local function add(a: number, b: number)
+            return a + b
+        end
+        return { add = add }
+    )");
+    auto original = hashModuleInterface(serializeModuleInterface(*getMainModule()));
+
+    check(R"(
+        local function add(a: number, b: number)
+            local result = a + b
+            return result
+        end
+        return { add = add }
+    )");
+    CHECK_EQ(hashModuleInterface(serializeModuleInterface(*getMainModule())), original);
+
+    check(R"(
+        local function add(a: number, b: number)
+            return tostring(a + b)
+        end
+        return { add = add }
+    )");
+    CHECK_NE(hashModuleInterface(serializeModuleInterface(*getMainModule())), original);
+}
+
+TEST_CASE_FIXTURE(Fixture, "interface stub declares the exported types and return type of the module")
+{
+    check(R"(
+        export type Point = { x: number, y: number }
+        export type Box<T = string> = { value: T }
+
+        local function secret()
+            return "hidden"
+        end
+
+        return {
+            origin = function(): Point
+                return { x = 0, y = secret():len() }
+            end,
+        }
+    )");
+
+    auto stub = createInterfaceStub(*getMainModule());
+    REQUIRE(stub);
+    CHECK(stub->find("export type Point = ") != std::string::npos);
+    CHECK(stub->find("export type Box<T = string> = ") != std::string::npos);
+    CHECK(stub->find("secret") == std::string::npos);
+    CHECK(stub->find("return (nil :: any) :: ") != std::string::npos);
+
+    // The stub is valid source by itself, declaring the same interface
+    auto result = check(*stub);
+    CHECK(result.errors.empty());
+    CHECK_EQ(getMainModule()->exportedTypeBindings.size(), 2);
+    REQUIRE(getMainModule()->returnType);
+    CHECK(Luau::toString(getMainModule()->returnType).find("origin") != std::string::npos);
+}
+
+TEST_CASE_FIXTURE(Fixture, "interface stub is not created for interfaces containing cyclic types")
+{
+    check(R"(
+        export type Node = { value: number, next: Node? }
+        return {}
+    )");
+
+    CHECK_FALSE(createInterfaceStub(*getMainModule()));
+}
+
+TEST_SUITE_END();
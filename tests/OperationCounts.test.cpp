@@ -0,0 +1,402 @@
+#include "doctest.h"
+#include "Fixture.h"
+#include "LSP/LanguageServer.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+// These scenarios assert upper bounds on the work performed by the workspace, to catch regressions
+// where a feature silently rechecks or reparses more than it needs to
+
+TEST_SUITE_BEGIN("OperationCounts");
+
+static std::filesystem::path getRoot()
+{
+    std::error_code ec;
+    return std::filesystem::weakly_canonical(std::filesystem::temp_directory_path(), ec) / "luau-lsp-operation-counts";
+}
+
+static Uri openDocument(Fixture& fixture, const std::string& fileName, const std::string& source)
+{
+    // Documents are opened at real paths, so that they can be required relative to each other
+    auto uri = Uri::file(getRoot() / fileName);
+    fixture.workspace.openTextDocument(uri, {{uri, "luau", 0, source}});
+    return uri;
+}
+
+static Uri writeFile(const std::string& fileName, const std::string& source)
+{
+    std::filesystem::create_directories(getRoot());
+    std::ofstream(getRoot() / fileName) << source;
+    return Uri::file(getRoot() / fileName);
+}
+
+static void editDocument(Fixture& fixture, const Uri& uri, size_t version, const std::string& source)
+{
+    lsp::DidChangeTextDocumentParams params;
+    params.textDocument.uri = uri;
+    params.textDocument.version = version;
+    params.contentChanges.push_back({std::nullopt, source});
+    fixture.workspace.updateTextDocument(uri, params);
+}
+
+static lsp::DocumentDiagnosticParams diagnosticParams(const Uri& uri)
+{
+    lsp::DocumentDiagnosticParams params;
+    params.textDocument.uri = uri;
+    return params;
+}
+
+TEST_CASE_FIXTURE(Fixture, "editing a function body in a dependency rechecks each affected module once")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    auto dependency = openDocument(*this, "A.luau", R"(
+        local function value()
+            return 1
+        end
+        return { value = value }
+    )");
+    auto dependent = openDocument(*this, "B.luau", R"(
+        local A = require("./A.luau")
+        return A.value()
+    )");
+
+    workspace.documentDiagnostics(diagnosticParams(dependent));
+
+    auto before = workspace.getOperationCounts();
+    editDocument(*this, dependency, 1, R"(
+        local function value()
+            local result = 2
+            return result
+        end
+        return { value = value }
+    )");
+    workspace.documentDiagnostics(diagnosticParams(dependency));
+    auto delta = workspace.getOperationCounts() - before;
+
+    // Checking the dependency does not check its dependent
+    CHECK_EQ(delta.checks, 1);
+    CHECK_EQ(delta.modulesChecked, 1);
+    CHECK_LE(delta.parses, 1);
+    CHECK_EQ(delta.sourcemapUpdates, 0);
+
+    // The dependent is rechecked once when its diagnostics are requested, without rechecking the dependency
+    before = workspace.getOperationCounts();
+    workspace.documentDiagnostics(diagnosticParams(dependent));
+    delta = workspace.getOperationCounts() - before;
+
+    CHECK_EQ(delta.checks, 1);
+    CHECK_EQ(delta.modulesChecked, 1);
+    CHECK_LE(delta.parses, 1);
+
+    before = workspace.getOperationCounts();
+    workspace.documentDiagnostics(diagnosticParams(dependent));
+    CHECK_EQ((workspace.getOperationCounts() - before).modulesChecked, 0);
+}
+
+TEST_CASE_FIXTURE(Fixture, "dependents are marked dirty as a dependency changes but only re-diagnosed on save when rechecked on save")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+    client->globalConfig.diagnostics.dependentsMode = DependentsModeConfig::OnSave;
+
+    auto dependency = openDocument(*this, "SavedA.luau", R"(
+        return { value = 1 }
+    )");
+    auto dependent = openDocument(*this, "SavedB.luau", R"(
+        local A = require("./SavedA.luau")
+        local value = A.value
+        return value
+    )");
+
+    workspace.documentDiagnostics(diagnosticParams(dependent));
+    auto dependentName = workspace.fileResolver.getModuleName(dependent);
+
+    std::vector<Luau::ModuleName> markedDirty;
+    lsp::DidChangeTextDocumentParams params;
+    params.textDocument.uri = dependency;
+    params.textDocument.version = 1;
+    params.contentChanges.push_back({std::nullopt, "return { value = \"1\" }"});
+    workspace.updateTextDocument(dependency, params, &markedDirty);
+
+    // The dependent's diagnostics are not recomputed yet, but it must not keep using the types of the dependency's previous module
+    CHECK(markedDirty.empty());
+    CHECK(workspace.frontend.isDirty(dependentName));
+
+    lsp::HoverParams hoverParams;
+    hoverParams.textDocument.uri = dependent;
+    hoverParams.position = lsp::Position{2, 15};
+    auto hover = workspace.hover(hoverParams);
+    REQUIRE(hover);
+    CHECK_NE(hover->contents.value.find("string"), std::string::npos);
+
+    workspace.saveTextDocument(dependency, &markedDirty);
+    REQUIRE_EQ(markedDirty.size(), 1);
+    CHECK_EQ(markedDirty[0], dependentName);
+
+    // Saving again without further edits does not recompute the dependents
+    markedDirty.clear();
+    workspace.saveTextDocument(dependency, &markedDirty);
+    CHECK(markedDirty.empty());
+}
+
+TEST_CASE_FIXTURE(Fixture, "requesting diagnostics twice without edits does not recheck")
+{
+    auto uri = openDocument(*this, "Module.luau", R"(
+        local x = 1
+        return x
+    )");
+
+    workspace.documentDiagnostics(diagnosticParams(uri));
+
+    auto before = workspace.getOperationCounts();
+    workspace.documentDiagnostics(diagnosticParams(uri));
+    auto delta = workspace.getOperationCounts() - before;
+
+    CHECK_EQ(delta.modulesChecked, 0);
+    CHECK_EQ(delta.parses, 0);
+    CHECK_EQ(delta.sourceReads, 0);
+}
+
+TEST_CASE_FIXTURE(Fixture, "computing diagnostics does not build the autocomplete globals")
+{
+    auto uri = openDocument(*this, "Startup.luau", "local x = 1");
+    workspace.documentDiagnostics(diagnosticParams(uri));
+
+    // The autocomplete globals are built afterwards as background work, and only once
+    CHECK(workspace.ensureAutocompleteGlobals());
+    CHECK_FALSE(workspace.ensureAutocompleteGlobals());
+}
+
+TEST_CASE_FIXTURE(Fixture, "hovering twice performs one check")
+{
+    auto uri = openDocument(*this, "Hover.luau", R"(
+        local value = 1
+        print(value)
+    )");
+
+    lsp::HoverParams params;
+    params.textDocument.uri = uri;
+    params.position = lsp::Position{2, 15};
+
+    auto before = workspace.getOperationCounts();
+    workspace.hover(params);
+    workspace.hover(params);
+    auto delta = workspace.getOperationCounts() - before;
+
+    CHECK_LE(delta.modulesChecked, 1);
+    CHECK_LE(delta.parses, 1);
+}
+
+TEST_CASE_FIXTURE(Fixture, "editing a document does not rebuild the sourcemap")
+{
+    auto uri = openDocument(*this, "Edit.luau", "local x = 1");
+
+    auto before = workspace.getOperationCounts();
+    editDocument(*this, uri, 1, "local x = 2");
+    workspace.documentDiagnostics(diagnosticParams(uri));
+    auto delta = workspace.getOperationCounts() - before;
+
+    CHECK_EQ(delta.sourcemapUpdates, 0);
+    CHECK_EQ(delta.modulesChecked, 1);
+}
+
+TEST_CASE_FIXTURE(Fixture, "renaming a file remaps its module without reparsing unrelated modules")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    auto renamed = writeFile("Renamed.luau", "return { value = 1 }");
+    writeFile("Unrelated.luau", "return 2");
+    auto dependent = openDocument(*this, "RenamedDependent.luau", R"(
+        local Renamed = require("./Renamed.luau")
+        return Renamed.value
+    )");
+    auto unrelatedDependent = openDocument(*this, "UnrelatedDependent.luau", R"(
+        local Unrelated = require("./Unrelated.luau")
+        return Unrelated
+    )");
+
+    workspace.documentDiagnostics(diagnosticParams(dependent));
+    workspace.documentDiagnostics(diagnosticParams(unrelatedDependent));
+
+    auto newUri = Uri::file(getRoot() / "RenamedNew.luau");
+    std::filesystem::rename(renamed.fsPath(), newUri.fsPath());
+
+    auto before = workspace.getOperationCounts();
+    CHECK_EQ(workspace.renameFile(renamed, newUri), 1);
+
+    auto oldName = workspace.fileResolver.getModuleName(renamed);
+    auto newName = workspace.fileResolver.getModuleName(newUri);
+    CHECK_FALSE(contains(workspace.frontend.sourceNodes, oldName));
+    REQUIRE(contains(workspace.frontend.sourceNodes, newName));
+    CHECK(workspace.frontend.getSourceModule(newName));
+
+    // Only the dependent whose require no longer resolves is invalidated
+    CHECK(workspace.frontend.isDirty(workspace.fileResolver.getModuleName(dependent)));
+    CHECK_FALSE(workspace.frontend.isDirty(workspace.fileResolver.getModuleName(unrelatedDependent)));
+
+    workspace.documentDiagnostics(diagnosticParams(unrelatedDependent));
+    auto delta = workspace.getOperationCounts() - before;
+
+    CHECK_EQ(delta.modulesChecked, 0);
+    CHECK_EQ(delta.parses, 0);
+    CHECK_EQ(delta.sourceReads, 0);
+
+    std::filesystem::remove(newUri.fsPath());
+    std::filesystem::remove(getRoot() / "Unrelated.luau");
+}
+
+static std::vector<std::string> completionLabels(WorkspaceFolder& workspace, const lsp::CompletionParams& params)
+{
+    std::vector<std::string> labels;
+    for (const auto& item : workspace.completion(params))
+        labels.push_back(item.label);
+    std::sort(labels.begin(), labels.end());
+    return labels;
+}
+
+TEST_CASE_FIXTURE(Fixture, "completion tables are built once and rebuilt when the globals change")
+{
+    auto root = getRoot() / "CompletionTables";
+    std::filesystem::create_directories(root);
+    std::ofstream(root / "globalTypes.d.luau") << R"(
+        declare class Instance
+            function IsA(self, className: string): boolean
+            function FindFirstChildWhichIsA(self, className: string): Instance?
+            function FindFirstChildOfClass(self, className: string): Instance?
+            function FindFirstAncestorWhichIsA(self, className: string): Instance?
+            function FindFirstAncestorOfClass(self, className: string): Instance?
+            function Clone(self): Instance
+            function GetPropertyChangedSignal(self, property: string): any
+        end
+        declare class Part extends Instance end
+    )";
+    std::ofstream(root / "sourcemap.json") << R"({"name": "Project", "className": "Folder", "children": []})";
+    client->definitionsFiles = {root / "globalTypes.d.luau"};
+
+    WorkspaceFolder folder(client, "CompletionTables", Uri::file(root), std::nullopt);
+    folder.initialize();
+
+    auto uri = Uri::file(root / "Module.luau");
+    folder.openTextDocument(uri, {{uri, "luau", 0, "local part: Instance = nil :: any\npart:IsA(\"\")\n"}});
+
+    lsp::CompletionParams params;
+    params.textDocument.uri = uri;
+    params.position = lsp::Position{1, 10};
+
+    // The first completion builds the autocomplete globals, and then the tables derived from them
+    auto before = folder.getOperationCounts();
+    auto labels = completionLabels(folder, params);
+    CHECK_EQ(completionLabels(folder, params), labels);
+    CHECK_EQ((folder.getOperationCounts() - before).completionTableBuilds, 1);
+    CHECK_FALSE(folder.ensureAutocompleteGlobals());
+    CHECK(std::find(labels.begin(), labels.end(), "Part") != labels.end());
+
+    // Registering the instance types of a new sourcemap rebuilds the tables on next use, with the same results
+    before = folder.getOperationCounts();
+    CHECK(folder.updateSourceMap(InvalidationCause::SourcemapChanged));
+    CHECK_EQ((folder.getOperationCounts() - before).completionTableBuilds, 0);
+    CHECK_EQ(completionLabels(folder, params), labels);
+    CHECK_EQ((folder.getOperationCounts() - before).completionTableBuilds, 1);
+}
+
+TEST_CASE_FIXTURE(Fixture, "a dependency whose interface is unchanged since the previous session is not checked on a cold start")
+{
+    std::error_code ec;
+    auto root = getRoot() / "InterfaceStubs";
+    std::filesystem::remove_all(root, ec);
+    std::filesystem::create_directories(root);
+    std::ofstream(root / "Helper.luau") << "--!strict\nreturn function(x: number): number\n    return x\nend\n";
+    std::ofstream(root / "Dependency.luau") << R"(--!strict
+        local helper = require("./Helper.luau")
+        export type Point = { x: number, y: number }
+        local function origin(): Point
+            return { x = helper(0), y = helper(0) }
+        end
+        return { origin = origin }
+    )";
+
+    client->cacheDirectory = root / "cache";
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+    client->globalConfig.sourcemap.enabled = false;
+
+    auto uri = Uri::file(root / "Dependent.luau");
+    auto startSession = [&](WorkspaceFolder& folder)
+    {
+        folder.initialize();
+        folder.setupWithConfiguration(client->globalConfig);
+        folder.openTextDocument(uri, {{uri, "luau", 0, R"(--!strict
+            local Dependency = require("./Dependency.luau")
+            local point: Dependency.Point = Dependency.origin()
+            local name: string = point.x
+        )"}});
+    };
+
+    // The first session checks every module, and persists their interfaces
+    std::vector<lsp::Diagnostic> diagnostics;
+    {
+        WorkspaceFolder folder(client, "InterfaceStubs", Uri::file(root), std::nullopt);
+        startSession(folder);
+        diagnostics = folder.documentDiagnostics(diagnosticParams(uri)).items;
+        folder.saveCaches();
+    }
+    REQUIRE_EQ(diagnostics.size(), 1);
+
+    // The next session checks the persisted interface of the dependency in its place, so its own dependencies are not checked either
+    {
+        WorkspaceFolder folder(client, "InterfaceStubs", Uri::file(root), std::nullopt);
+        startSession(folder);
+        auto dependency = folder.fileResolver.getModuleName(Uri::file(root / "Dependency.luau"));
+
+        auto before = folder.getOperationCounts();
+        auto report = folder.documentDiagnostics(diagnosticParams(uri));
+        CHECK_EQ((folder.getOperationCounts() - before).modulesChecked, 2);
+        CHECK(contains(folder.fileResolver.interfaceStubs, dependency));
+        REQUIRE_EQ(report.items.size(), 1);
+        CHECK_EQ(report.items[0].message, diagnostics[0].message);
+
+        // Features which need the definitions of the dependency check its real source
+        folder.checkStrict(folder.fileResolver.getModuleName(uri));
+        CHECK_FALSE(contains(folder.fileResolver.interfaceStubs, dependency));
+        CHECK_EQ(folder.invalidationLog.latest(dependency)->cause, InvalidationCause::InterfaceStubReleased);
+    }
+
+    // Changing the interface of a module the dependency requires means the persisted interface of the dependency may be out of date
+    std::ofstream(root / "Helper.luau") << "--!strict\nreturn function(x: number): string\n    return tostring(x)\nend\n";
+    {
+        WorkspaceFolder folder(client, "InterfaceStubs", Uri::file(root), std::nullopt);
+        startSession(folder);
+        folder.documentDiagnostics(diagnosticParams(uri));
+        CHECK(folder.fileResolver.interfaceStubs.empty());
+    }
+
+    std::filesystem::remove_all(root, ec);
+}
+
+TEST_CASE("a repeated hover is answered from the previous response until a notification modifies server state")
+{
+    CapturedOutput captured;
+    LanguageServer server({}, {}, std::nullopt);
+    server.onRequest(1, "initialize", json{{"capabilities", json::object()}});
+    server.onNotification("initialized", json::object());
+
+    auto uri = Uri::file(getRoot() / "Memo.luau");
+    server.onNotification("textDocument/didOpen",
+        json{{"textDocument", {{"uri", uri}, {"languageId", "luau"}, {"version", 0}, {"text", "local value = 1\nprint(value)\n"}}}});
+    auto workspace = server.findWorkspace(uri);
+
+    json hoverParams{{"textDocument", {{"uri", uri}}}, {"position", {{"line", 1}, {"character", 7}}}};
+    auto before = workspace->getOperationCounts();
+    server.onRequest(2, "textDocument/hover", hoverParams);
+    server.onRequest(3, "textDocument/hover", hoverParams);
+    CHECK_EQ((workspace->getOperationCounts() - before).checks, 1);
+
+    server.onNotification("textDocument/didChange",
+        json{{"textDocument", {{"uri", uri}, {"version", 1}}}, {"contentChanges", {{{"text", "local value = \"1\"\nprint(value)\n"}}}}});
+
+    before = workspace->getOperationCounts();
+    server.onRequest(4, "textDocument/hover", hoverParams);
+    CHECK_EQ((workspace->getOperationCounts() - before).checks, 1);
+}
+
+TEST_SUITE_END();
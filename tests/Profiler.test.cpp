@@ -0,0 +1,81 @@
+#include "doctest.h"
+#include "LSP/Profiler.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+TEST_SUITE_BEGIN("Profiler");
+
+TEST_CASE("profile is only written once the duration has elapsed")
+{
+    if (!Profiler::isSupported())
+        return;
+
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-profiler-test.folded";
+    std::filesystem::remove(path);
+
+    Profiler profiler;
+    profiler.start(ProfileParams{/* duration: */ 0.2, /* path: */ path.generic_string(), /* frequency: */ 1000});
+    CHECK(profiler.isRunning());
+    CHECK_THROWS(profiler.start(ProfileParams{/* duration: */ 0.2, /* path: */ path.generic_string(), /* frequency: */ 1000}));
+
+    // Burn CPU time so that samples are taken
+    volatile double sink = 0;
+    std::optional<std::string> summary = std::nullopt;
+    while (!summary)
+    {
+        for (int i = 0; i < 10000; i++)
+            sink = sink + std::sqrt(static_cast<double>(i));
+        summary = profiler.poll();
+    }
+
+    CHECK_FALSE(profiler.isRunning());
+    CHECK_NE(summary->find(path.generic_string()), std::string::npos);
+
+    std::ifstream output(path);
+    std::string line;
+    REQUIRE(std::getline(output, line));
+    // Each line is a semicolon separated stack followed by the sample count
+    auto countStart = line.find_last_of(' ');
+    REQUIRE_NE(countStart, std::string::npos);
+    CHECK_GT(std::stoi(line.substr(countStart + 1)), 0);
+}
+
+TEST_CASE("forcing a poll stops the profile early")
+{
+    if (!Profiler::isSupported())
+        return;
+
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-profiler-test-forced.folded";
+
+    Profiler profiler;
+    profiler.start(ProfileParams{/* duration: */ 60.0, /* path: */ path.generic_string(), /* frequency: */ 100});
+    CHECK_FALSE(profiler.poll());
+    CHECK(profiler.poll(/* force: */ true));
+    CHECK_FALSE(profiler.isRunning());
+    CHECK(std::filesystem::exists(path));
+}
+
+TEST_CASE("an idle profile is written once its deadline is reached")
+{
+    if (!Profiler::isSupported())
+        return;
+
+    auto path = std::filesystem::temp_directory_path() / "luau-lsp-profiler-test-idle.folded";
+    std::filesystem::remove(path);
+
+    Profiler profiler;
+    CHECK_FALSE(profiler.getDeadline());
+    profiler.start(ProfileParams{/* duration: */ 0.1, /* path: */ path.generic_string(), /* frequency: */ 100});
+
+    // The server waits for the deadline rather than for work, so no samples may have been taken
+    auto deadline = profiler.getDeadline();
+    REQUIRE(deadline);
+    std::this_thread::sleep_until(*deadline);
+    CHECK(profiler.poll());
+    CHECK_FALSE(profiler.getDeadline());
+    CHECK(std::filesystem::exists(path));
+}
+
+TEST_SUITE_END();
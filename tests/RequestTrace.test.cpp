@@ -0,0 +1,75 @@
+#include "doctest.h"
+#include "LSP/RequestTrace.hpp"
+
+TEST_SUITE_BEGIN("RequestTrace");
+
+TEST_CASE("spans are nested within the current trace")
+{
+    tracing::RequestTrace trace{"textDocument/hover"};
+    {
+        tracing::ScopedRequestTrace scopedTrace{trace};
+        tracing::ScopedSpan outer("checkStrict", "MainModule");
+        {
+            tracing::ScopedSpan inner("frontend.check");
+        }
+    }
+    trace.finish();
+
+    const auto& spans = trace.getSpans();
+    REQUIRE_EQ(spans.size(), 2);
+    CHECK_EQ(spans[0].name, "checkStrict");
+    CHECK_EQ(spans[0].detail, "MainModule");
+    CHECK_EQ(spans[0].depth, 0);
+    CHECK_EQ(spans[1].name, "frontend.check");
+    CHECK_EQ(spans[1].depth, 1);
+    CHECK_LE(spans[1].end, spans[0].end);
+}
+
+TEST_CASE("spans are not recorded when no request is being handled")
+{
+    CHECK_EQ(tracing::currentTrace(), nullptr);
+    tracing::ScopedSpan span("checkStrict");
+    tracing::step("check", "MainModule");
+}
+
+TEST_CASE("steps end when the next step begins or the enclosing span ends")
+{
+    tracing::RequestTrace trace{"textDocument/completion"};
+    {
+        tracing::ScopedRequestTrace scopedTrace{trace};
+        tracing::ScopedSpan span("checkStrict");
+        tracing::step("check", "Dependency");
+        tracing::step("check", "MainModule");
+    }
+    trace.finish();
+
+    const auto& spans = trace.getSpans();
+    REQUIRE_EQ(spans.size(), 3);
+    CHECK_EQ(spans[1].detail, "Dependency");
+    CHECK_EQ(spans[1].depth, 1);
+    CHECK_EQ(spans[1].end, spans[2].start);
+    CHECK_EQ(spans[2].detail, "MainModule");
+    CHECK_EQ(spans[2].end, spans[0].end);
+}
+
+TEST_CASE("short spans are omitted from the formatted breakdown")
+{
+    tracing::RequestTrace trace{"textDocument/hover", std::chrono::milliseconds(5)};
+    trace.beginSpan("handler");
+    trace.beginSpan("checkStrict", "MainModule");
+    trace.endSpan();
+    trace.endSpan();
+    trace.finish();
+
+    auto output = trace.format(std::chrono::hours(1));
+    CHECK_NE(output.find("textDocument/hover took"), std::string::npos);
+    CHECK_NE(output.find("waiting in queue: 5ms"), std::string::npos);
+    CHECK_EQ(output.find("checkStrict"), std::string::npos);
+    CHECK_NE(output.find("(2 spans shorter than 3600000ms omitted)"), std::string::npos);
+
+    output = trace.format(tracing::Clock::duration::zero());
+    CHECK_NE(output.find("  handler: "), std::string::npos);
+    CHECK_NE(output.find("    checkStrict MainModule: "), std::string::npos);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,99 @@
+#include "doctest.h"
+#include "LSP/RequireScanner.hpp"
+
+using Kind = RequireExpressionPart::Kind;
+
+TEST_SUITE_BEGIN("RequireScanner");
+
+TEST_CASE("scans string requires")
+{
+    auto scanned = scanRequires("local A = require(\"./A\")\nlocal B = require './B'\nlocal C = require [[C]]\n");
+    REQUIRE_EQ(scanned.size(), 3);
+    CHECK_EQ(scanned[0].expression, std::vector<RequireExpressionPart>{{Kind::String, "./A"}});
+    CHECK_EQ(scanned[1].expression, std::vector<RequireExpressionPart>{{Kind::String, "./B"}});
+    CHECK_EQ(scanned[2].expression, std::vector<RequireExpressionPart>{{Kind::String, "C"}});
+
+    CHECK_EQ(scanned[0].location, Luau::Location{{0, 10}, {0, 24}});
+    CHECK_EQ(scanned[1].location, Luau::Location{{1, 10}, {1, 23}});
+}
+
+TEST_CASE("scans instance requires")
+{
+    auto scanned = scanRequires(R"(
+        local Foo = require(script.Parent.Foo)
+        local Bar = require(game:GetService("ReplicatedStorage"):WaitForChild("Shared", 5)["Bar"])
+    )");
+    REQUIRE_EQ(scanned.size(), 2);
+
+    std::vector<RequireExpressionPart> foo{{Kind::Global, "script"}, {Kind::IndexName, "Parent"}, {Kind::IndexName, "Foo"}};
+    CHECK_EQ(scanned[0].expression, foo);
+
+    std::vector<RequireExpressionPart> bar{{Kind::Global, "game"}, {Kind::MethodCall, "GetService", "ReplicatedStorage", 1},
+        {Kind::MethodCall, "WaitForChild", "Shared", 2}, {Kind::IndexString, "Bar"}};
+    CHECK_EQ(scanned[1].expression, bar);
+}
+
+TEST_CASE("locals are substituted into requires")
+{
+    auto scanned = scanRequires(R"(
+        local ReplicatedStorage = game:GetService("ReplicatedStorage")
+        local Shared = ReplicatedStorage.Shared
+        local Foo = require(Shared.Foo)
+    )");
+    REQUIRE_EQ(scanned.size(), 1);
+
+    std::vector<RequireExpressionPart> foo{
+        {Kind::Global, "game"}, {Kind::MethodCall, "GetService", "ReplicatedStorage", 1}, {Kind::IndexName, "Shared"}, {Kind::IndexName, "Foo"}};
+    CHECK_EQ(scanned[0].expression, foo);
+}
+
+TEST_CASE("locals initialised to other expressions are not substituted")
+{
+    auto scanned = scanRequires(R"(
+        local Shared = script.Parent
+        local Shared = getShared() .. "/"
+        local Foo = require(Shared.Foo)
+    )");
+    REQUIRE_EQ(scanned.size(), 1);
+
+    std::vector<RequireExpressionPart> foo{{Kind::Global, "Shared"}, {Kind::IndexName, "Foo"}};
+    CHECK_EQ(scanned[0].expression, foo);
+}
+
+TEST_CASE("requires in comments and strings are skipped")
+{
+    auto scanned = scanRequires(R"(
+        -- require(script.A)
+        --[==[
+            require(script.B)
+        ]==]
+        local s = 'require(script.C)' .. ""
+        local t = `require({script.D})`
+        local u = [[require(script.E)]]
+        local Module = {}
+        Module.require(script.F)
+        local G = require(script.G)
+    )");
+    REQUIRE_EQ(scanned.size(), 1);
+    CHECK_EQ(scanned[0].expression.back(), RequireExpressionPart{Kind::IndexName, "G"});
+    CHECK_EQ(scanned[0].location.begin.line, 10);
+}
+
+TEST_CASE("requires within strings nested in interpolated strings are skipped")
+{
+    auto scanned = scanRequires("local s = `{ `require(script.A)` }`\nlocal B = require(script.B)\n");
+    REQUIRE_EQ(scanned.size(), 1);
+    CHECK_EQ(scanned[0].expression.back(), RequireExpressionPart{Kind::IndexName, "B"});
+}
+
+TEST_CASE("requires of unsupported expressions are skipped")
+{
+    auto scanned = scanRequires(R"(
+        local A = require(script.Parent:FindFirstChild(name))
+        local B = require(script.Parent.B .. "")
+        local C = require(getModule())
+    )");
+    CHECK(scanned.empty());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,177 @@
+#include "doctest.h"
+#include "LSP/ResumableRequest.hpp"
+
+#include <stdexcept>
+#include <string>
+
+TEST_SUITE_BEGIN("ResumableRequest");
+
+TEST_CASE("forEach visits one item per unit of work")
+{
+    std::vector<int> visited;
+    auto resumable = forEach<int>(
+        std::vector<int>{1, 2, 3}, 0,
+        [&](const int& item, int& sum)
+        {
+            visited.push_back(item);
+            sum += item;
+        },
+        [](int&& sum)
+        {
+            return sum * 10;
+        });
+
+    CHECK_FALSE(resumable());
+    CHECK_EQ(visited, std::vector<int>{1});
+    CHECK_FALSE(resumable());
+    CHECK_EQ(resumable(), 60);
+    CHECK_EQ(visited, std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("forEach with no items completes immediately")
+{
+    auto resumable = forEach<std::string>(
+        std::vector<int>{}, std::string{"empty"},
+        [](const int&, std::string&) {},
+        [](std::string&& result)
+        {
+            return std::move(result);
+        });
+
+    CHECK_EQ(resumable(), "empty");
+}
+
+TEST_CASE("sequence runs each part in turn and combines their results")
+{
+    std::vector<Resumable<std::vector<int>>> parts;
+    parts.push_back(forEach<std::vector<int>>(
+        std::vector<int>{1, 2}, std::vector<int>{},
+        [](const int& item, std::vector<int>& result)
+        {
+            result.push_back(item);
+        },
+        [](std::vector<int>&& result)
+        {
+            return std::move(result);
+        }));
+    parts.push_back(ready(std::vector<int>{3}));
+
+    auto resumable = sequence(std::move(parts), std::vector<int>{},
+        [](std::vector<int>& result, std::vector<int>&& part)
+        {
+            result.insert(result.end(), part.begin(), part.end());
+        });
+
+    auto mapped = mapResult<size_t>(std::move(resumable),
+        [](std::vector<int>&& result)
+        {
+            return result.size();
+        });
+
+    CHECK_FALSE(mapped());
+    CHECK_FALSE(mapped());
+    CHECK_EQ(mapped(), 3);
+}
+
+TEST_CASE("the scheduler interleaves the units of work of pending requests")
+{
+    std::vector<std::string> log;
+    auto makeRequest = [&](const std::string& name, int units)
+    {
+        return [&log, name, units]() -> RequestScheduler::ResumeFunction
+        {
+            auto remaining = std::make_shared<int>(units);
+            return [&log, name, remaining]()
+            {
+                log.push_back(name);
+                *remaining -= 1;
+                return *remaining == 0;
+            };
+        };
+    };
+
+    RequestScheduler scheduler;
+    scheduler.schedule(1, makeRequest("references", 3));
+    scheduler.schedule(2, makeRequest("symbols", 2));
+
+    while (!scheduler.empty())
+        scheduler.resumeNext();
+
+    CHECK_EQ(log, std::vector<std::string>{"references", "symbols", "references", "symbols", "references"});
+}
+
+TEST_CASE("cancelled and failed requests are removed from the scheduler")
+{
+    RequestScheduler scheduler;
+    scheduler.schedule(1,
+        []() -> RequestScheduler::ResumeFunction
+        {
+            return []()
+            {
+                return false;
+            };
+        });
+    scheduler.schedule("two",
+        []() -> RequestScheduler::ResumeFunction
+        {
+            return []() -> bool
+            {
+                throw std::runtime_error("failed");
+            };
+        });
+
+    CHECK(scheduler.cancel(1));
+    CHECK_FALSE(scheduler.cancel(1));
+
+    REQUIRE_FALSE(scheduler.empty());
+    CHECK_EQ(scheduler.nextId(), json_rpc::id_type("two"));
+    CHECK_THROWS(scheduler.resumeNext());
+    CHECK(scheduler.empty());
+
+    scheduler.schedule(3,
+        []() -> RequestScheduler::ResumeFunction
+        {
+            return []()
+            {
+                return false;
+            };
+        });
+    CHECK_EQ(scheduler.cancelAll(), std::vector<json_rpc::id_type>{3});
+    CHECK(scheduler.empty());
+}
+
+TEST_CASE("restarted requests start over when they are next resumed")
+{
+    size_t starts = 0;
+    std::vector<int> visited;
+    RequestScheduler scheduler;
+    scheduler.schedule(1,
+        [&]() -> RequestScheduler::ResumeFunction
+        {
+            starts += 1;
+            auto next = std::make_shared<int>(0);
+            return [&visited, next]()
+            {
+                visited.push_back(*next);
+                *next += 1;
+                return *next == 3;
+            };
+        });
+
+    CHECK_EQ(starts, 0);
+    scheduler.resumeNext();
+    scheduler.resumeNext();
+    CHECK_EQ(starts, 1);
+
+    scheduler.restartAll();
+    CHECK_FALSE(scheduler.empty());
+    CHECK_EQ(starts, 1);
+
+    while (!scheduler.empty())
+        scheduler.resumeNext();
+
+    CHECK_EQ(starts, 2);
+    CHECK_EQ(visited, std::vector<int>{0, 1, 0, 1, 2});
+}
+
+TEST_SUITE_END();
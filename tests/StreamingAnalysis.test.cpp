@@ -0,0 +1,108 @@
+#include "doctest.h"
+#include "Fixture.h"
+#include "Analyze/StreamingAnalysis.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+TEST_SUITE_BEGIN("StreamingAnalysis");
+
+static std::filesystem::path getRoot()
+{
+    std::error_code ec;
+    return std::filesystem::weakly_canonical(std::filesystem::temp_directory_path(), ec) / "luau-lsp-streaming-analysis";
+}
+
+static std::filesystem::path writeFile(const std::string& fileName, const std::string& source)
+{
+    std::filesystem::create_directories(getRoot());
+    std::ofstream(getRoot() / fileName) << source;
+    return getRoot() / fileName;
+}
+
+/// Checks the files in the same way as `analyze --stream`, returning the files whose source module was missing when they were analyzed
+static std::vector<std::string> analyzeStreaming(Fixture& fixture, const std::vector<std::filesystem::path>& files)
+{
+    auto& frontend = fixture.workspace.frontend;
+    auto graph = scanDependencyGraph(fixture.workspace.fileResolver, files);
+    auto ordered = orderByDependencies(files, graph);
+    StreamingReleaser releaser(frontend, graph, ordered);
+
+    std::vector<std::string> missing;
+    for (const auto& path : ordered)
+    {
+        auto name = path.generic_string();
+        if (frontend.isDirty(name))
+            frontend.check(name);
+        if (!frontend.getSourceModule(name))
+            missing.push_back(name);
+        releaser.markChecked(name);
+    }
+
+    return missing;
+}
+
+static size_t positionOf(const std::vector<std::filesystem::path>& files, const std::filesystem::path& file)
+{
+    return std::find(files.begin(), files.end(), file) - files.begin();
+}
+
+TEST_CASE_FIXTURE(Fixture, "files in a require cycle are not released before they are analyzed")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    auto a = writeFile("CycleA.luau", R"(
+        local B = require("./CycleB.luau")
+        return {}
+    )");
+    auto b = writeFile("CycleB.luau", R"(
+        local A = require("./CycleA.luau")
+        return {}
+    )");
+
+    CHECK(analyzeStreaming(*this, {a, b}).empty());
+
+    // Once both files are analyzed, neither is needed
+    CHECK_FALSE(workspace.frontend.getSourceModule(a.generic_string()));
+    CHECK_FALSE(workspace.frontend.getSourceModule(b.generic_string()));
+}
+
+TEST_CASE_FIXTURE(Fixture, "a diamond of requires is analyzed in dependency order and released once every file is analyzed")
+{
+    client->globalConfig.require.mode = RequireModeConfig::RelativeToFile;
+
+    auto base = writeFile("DiamondBase.luau", R"(
+        return { value = 1 }
+    )");
+    auto left = writeFile("DiamondLeft.luau", R"(
+        local Base = require("./DiamondBase.luau")
+        return { value = Base.value }
+    )");
+    auto right = writeFile("DiamondRight.luau", R"(
+        local Base = require("./DiamondBase.luau")
+        return { value = Base.value }
+    )");
+    auto top = writeFile("DiamondTop.luau", R"(
+        local Left = require("./DiamondLeft.luau")
+        local Right = require("./DiamondRight.luau")
+        return Left.value + Right.value
+    )");
+
+    std::vector<std::filesystem::path> files{top, right, left, base};
+    auto graph = scanDependencyGraph(workspace.fileResolver, files);
+    CHECK_EQ(graph.dependentCounts[base.generic_string()], 2);
+
+    auto ordered = orderByDependencies(files, graph);
+    REQUIRE_EQ(ordered.size(), 4);
+    CHECK_LT(positionOf(ordered, base), positionOf(ordered, left));
+    CHECK_LT(positionOf(ordered, base), positionOf(ordered, right));
+    CHECK_LT(positionOf(ordered, left), positionOf(ordered, top));
+    CHECK_LT(positionOf(ordered, right), positionOf(ordered, top));
+
+    CHECK(analyzeStreaming(*this, files).empty());
+
+    for (const auto& file : files)
+        CHECK_FALSE(workspace.frontend.getSourceModule(file.generic_string()));
+}
+
+TEST_SUITE_END();
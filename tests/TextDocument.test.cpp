@@ -524,6 +524,53 @@ TEST_CASE("Several incremental content changes")
     assertValidLineNumbers(document);
 }
 
+TEST_CASE("Several incremental content changes in reverse document order")
+{
+    // Multi-cursor edits are sent with the last change in the document first
+    auto document = newDocument("local a = 1\nlocal b = 2\nlocal c = 3");
+    document.update(
+        {
+            {lsp::Range{{2, 6}, {2, 7}}, "gamma"},
+            {lsp::Range{{1, 6}, {1, 7}}, "beta\n"},
+            {lsp::Range{{0, 10}, {1, 0}}, "10 "},
+            {lsp::Range{{0, 6}, {0, 7}}, "alpha"},
+        },
+        1);
+    CHECK_EQ(document.version(), 1);
+    CHECK_EQ(document.getText(), "local alpha = 10 local beta\n = 2\nlocal gamma = 3");
+    CHECK_EQ(document.lineCount(), 3);
+    assertValidLineNumbers(document);
+}
+
+TEST_CASE("Several incremental content changes at the same position in reverse document order")
+{
+    auto document = newDocument("foo\nbar");
+    document.update(
+        {
+            {lsp::Range{{1, 0}, {1, 0}}, "b\n"},
+            {lsp::Range{{1, 0}, {1, 0}}, "a\n"},
+        },
+        1);
+    CHECK_EQ(document.getText(), "foo\na\nb\nbar");
+    CHECK_EQ(document.lineCount(), 4);
+    assertValidLineNumbers(document);
+}
+
+TEST_CASE("Several incremental content changes where a later change is positioned in content inserted by an earlier change")
+{
+    // The second position is past the end of the original content, so it only exists once the first change has been applied
+    auto document = newDocument("ab");
+    document.update(
+        {
+            {lsp::Range{{0, 2}, {0, 2}}, "\n"},
+            {lsp::Range{{1, 0}, {1, 0}}, "Z"},
+        },
+        1);
+    CHECK_EQ(document.getText(), "ab\nZ");
+    CHECK_EQ(document.lineCount(), 2);
+    assertValidLineNumbers(document);
+}
+
 TEST_CASE("Basic append")
 {
     auto document = newDocument("foooo\nbar\nbaz");
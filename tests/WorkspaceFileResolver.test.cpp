@@ -134,4 +134,71 @@ TEST_CASE_FIXTURE(Fixture, "string require doesn't replace a non-luau/lua extens
     CHECK_EQ(resolved->name, "/Module.mod.lua");
 }
 
+TEST_CASE("resolveRequireExpression resolves each part relative to the previous part")
+{
+    WorkspaceFileResolver fileResolver;
+
+    auto scanned = scanRequires(R"(
+        local Players = game:GetService("Players")
+        local Client = require(Players.LocalPlayer.PlayerScripts:WaitForChild("Client"))
+        local Shared = require(game:GetService("ReplicatedStorage"):FindFirstChild("Shared", true))
+    )");
+    REQUIRE_EQ(scanned.size(), 2);
+
+    auto resolved = fileResolver.resolveRequireExpression("game/ServerScriptService/Script", scanned[0].expression);
+    REQUIRE(resolved.has_value());
+    CHECK_EQ(resolved->name, "game/StarterPlayer/StarterPlayerScripts/Client");
+
+    // Recursive FindFirstChild is not resolved, matching resolveModule
+    CHECK_FALSE(fileResolver.resolveRequireExpression("game/ServerScriptService/Script", scanned[1].expression));
+}
+
+TEST_CASE("isPackageFile matches files against the package globs")
+{
+    auto client = std::make_shared<Client>(Client{});
+    client->globalConfig.packageGlobs = {"Packages/**"};
+
+    WorkspaceFileResolver fileResolver;
+    fileResolver.rootUri = Uri::file(std::filesystem::current_path());
+    fileResolver.client = client;
+
+    CHECK(fileResolver.isPackageFile(std::filesystem::current_path() / "Packages" / "_Index" / "package" / "init.lua"));
+    CHECK_FALSE(fileResolver.isPackageFile(std::filesystem::current_path() / "src" / "init.lua"));
+
+    ClientConfiguration config;
+    config.packageGlobs = {"src/**"};
+    CHECK(fileResolver.isPackageFile(std::filesystem::current_path() / "src" / "init.lua", config));
+}
+
+TEST_CASE("Wally packages are package files by default")
+{
+    auto client = std::make_shared<Client>(Client{});
+
+    WorkspaceFileResolver fileResolver;
+    fileResolver.rootUri = Uri::file(std::filesystem::current_path());
+    fileResolver.client = client;
+
+    CHECK(fileResolver.isPackageFile(std::filesystem::current_path() / "Packages" / "_Index" / "package" / "init.lua"));
+    CHECK_FALSE(fileResolver.isPackageFile(std::filesystem::current_path() / "Packages" / "init.lua"));
+}
+
+TEST_CASE("isPackageFile results are cached until the config cache is cleared")
+{
+    auto client = std::make_shared<Client>(Client{});
+    client->globalConfig.packageGlobs = {"Packages/**"};
+
+    WorkspaceFileResolver fileResolver;
+    fileResolver.rootUri = Uri::file(std::filesystem::current_path());
+    fileResolver.client = client;
+
+    auto path = std::filesystem::current_path() / "Packages" / "init.lua";
+    CHECK(fileResolver.isPackageFile(path));
+
+    client->globalConfig.packageGlobs = {};
+    CHECK(fileResolver.isPackageFile(path));
+
+    fileResolver.clearConfigCache();
+    CHECK_FALSE(fileResolver.isPackageFile(path));
+}
+
 TEST_SUITE_END();